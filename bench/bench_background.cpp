@@ -0,0 +1,106 @@
+// Plays on a world while the background generator is still building it: bodies walk out
+// from the spawn columns in both directions and random tiles around the surface are dug
+// every tick, the way the game runs once the spawn region is ready. No body may ever
+// overlap a column that isn't ready, edits must only land where CanEdit allows them, and
+// once generation finishes every column nobody dug must match a world generated in one go.
+//
+// Usage: bench_background [seed]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "physics/physicsSystem.hpp"
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    unsigned int seed = argc > 1 ? (unsigned int)atoi(argv[1]) : 2023;
+    const int spawnRegionChunks = 3; // as Game waits for
+    const int editsPerTick = 4;
+    const int bodyCount = 8;
+
+    World reference(seed);
+    reference.GenerateTerrain();
+
+    World world(seed);
+    int spawnChunkX = (world.getWidth() / 2) >> chunkShift;
+    auto start = Clock::now();
+    world.StartGenerating(spawnChunkX);
+    for (int cx = spawnChunkX - spawnRegionChunks; cx <= spawnChunkX + spawnRegionChunks; ++cx) {
+        while (!world.IsColumnReady(cx)) std::this_thread::yield();
+    }
+    double spawnMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Walkers standing on the spawn columns, half heading each way
+    PhysicsSystem physics;
+    std::vector<PhysicsSystem::BodyId> bodies;
+    for (int i = 0; i < bodyCount; ++i) {
+        int x = spawnChunkX * chunkSize + i;
+        PhysicsSystem::BodyId body = physics.Add(x * tileSize, (world.GetTopSolidY(x) - 3) * tileSize, tileSize - 2,
+                                                 2 * tileSize - 2, PhysicsSystem::MATERIAL_PLAYER);
+        physics.flags[physics.IndexOf(body)] |= PhysicsSystem::BODY_ACTIVE;
+        bodies.push_back(body);
+    }
+
+    std::mt19937 rng(seed);
+    std::vector<bool> dug(world.getChunksX(), false);
+    std::vector<std::pair<int, int>> accepted;
+    int refused = 0, ticks = 0, intrusions = 0;
+    while (world.IsGenerating()) {
+        for (int i = 0; i < bodyCount; ++i) {
+            physics.vx[physics.IndexOf(bodies[i])] = i % 2 ? 300.0f : -300.0f;
+        }
+        physics.Step(1.0f / 60.0f, world);
+
+        // Readiness only ever moves forward, so a column unready now was unready during the step
+        for (PhysicsSystem::BodyId body : bodies) {
+            int index = physics.IndexOf(body);
+            int first = (int)(physics.x[index] / tileSize) >> chunkShift;
+            int last = (int)((physics.x[index] + physics.width[index]) / tileSize) >> chunkShift;
+            for (int cx = first; cx <= last; ++cx) intrusions += !world.IsColumnReady(cx);
+        }
+
+        for (int i = 0; i < editsPerTick; ++i) {
+            int x = rng() % world.getWidth();
+            int y = reference.GetTopSolidY(x) + (int)(rng() % 40);
+            if (y >= world.getHeight()) continue;
+            if (world.CanEdit(x, y)) {
+                world.SetTile(x, y, World::TILE_AIR);
+                dug[x >> chunkShift] = true;
+                accepted.push_back({ x, y });
+            } else {
+                world.SetTile(x, y, World::TILE_AIR); // must be ignored
+                ++refused;
+            }
+        }
+
+        ++ticks;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2)); // leave the worker a frame's slack
+    }
+    world.FinishGenerating();
+    double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    int mismatched = 0, untouched = 0;
+    for (int cx = 0; cx < world.getChunksX(); ++cx) {
+        if (dug[cx]) continue;
+        ++untouched;
+        mismatched += world.HashColumn(cx) != reference.HashColumn(cx);
+    }
+    int lostEdits = 0;
+    for (auto [x, y] : accepted) lostEdits += world.GetTile(x, y) != World::TILE_AIR;
+
+    printf("seed %u: spawn region ready after %.1f ms, generation done after %.1f ms\n", seed, spawnMs, totalMs);
+    printf("%d ticks played during generation, %zu edits made, %d refused\n\n", ticks, accepted.size(), refused);
+
+    bool stayedOk = intrusions == 0;
+    bool editsOk = lostEdits == 0 && mismatched == 0;
+    bool playedOk = ticks > 0 && refused > 0;
+    printf("bodies kept to ready columns: %d intrusions %s\n", intrusions, stayedOk ? "ok" : "FAILED");
+    printf("edits kept, %d undug columns as generated: %d lost, %d differ %s\n", untouched, lostEdits, mismatched,
+           editsOk ? "ok" : "FAILED");
+    printf("played while columns were still generating: %s\n", playedOk ? "ok" : "FAILED");
+    return stayedOk && editsOk && playedOk ? 0 : 1;
+}
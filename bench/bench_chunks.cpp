@@ -0,0 +1,83 @@
+// Compares chunked World tile access against the old flat y * width + x vector.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main() {
+    World world;
+    const int width = world.getWidth();
+    const int height = world.getHeight();
+    std::vector<int> flat(width * height);
+
+    std::mt19937 rng(1234);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int tile = rng() % 6;
+            world.at(x, y) = tile;
+            flat[y * width + x] = tile;
+        }
+    }
+
+    const int passes = 20;
+    const int randomReads = width * height;
+    std::vector<int> xs(randomReads), ys(randomReads);
+    for (int i = 0; i < randomReads; ++i) {
+        xs[i] = rng() % width;
+        ys[i] = rng() % height;
+    }
+
+    volatile int64_t sink = 0;
+    int64_t sum = 0;
+
+    auto start = Clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                sum += flat[y * width + x];
+    double flatScan = msSince(start);
+
+    start = Clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                sum += world.GetTile(x, y);
+    double chunkScan = msSince(start);
+
+    start = Clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int i = 0; i < randomReads; ++i)
+            sum += flat[ys[i] * width + xs[i]];
+    double flatRandom = msSince(start);
+
+    start = Clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int i = 0; i < randomReads; ++i)
+            sum += world.GetTile(xs[i], ys[i]);
+    double chunkRandom = msSince(start);
+
+    start = Clock::now();
+    for (int p = 0; p < passes; ++p)
+        for (int i = 0; i < randomReads; ++i)
+            sum += world.IsSolidTile(xs[i], ys[i]);
+    double chunkSolid = msSince(start);
+    sink = sum;
+
+    double reads = (double)passes * width * height / 1e6;
+    printf("%-24s %10s %14s\n", "access", "ms", "Mreads/s");
+    printf("%-24s %10.2f %14.1f\n", "flat scanline", flatScan, reads / (flatScan / 1000.0));
+    printf("%-24s %10.2f %14.1f\n", "chunked scanline", chunkScan, reads / (chunkScan / 1000.0));
+    printf("%-24s %10.2f %14.1f\n", "flat random", flatRandom, reads / (flatRandom / 1000.0));
+    printf("%-24s %10.2f %14.1f\n", "chunked random", chunkRandom, reads / (chunkRandom / 1000.0));
+    printf("%-24s %10.2f %14.1f\n", "chunked IsSolidTile", chunkSolid, reads / (chunkSolid / 1000.0));
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Drops players and items onto a generated world at a range of fall speeds and times
+// each vertical move with the swept resolver against the fixed sub-stepping it replaced
+// (reproduced below). The sub-stepper's cost grows with speed; the sweep's should not.
+// Every sweep landing must end flush on the ground without overlapping a solid tile,
+// and no more than one old sub-step away from where the sub-stepper stopped.
+//
+// Usage: bench_collision [bodies]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "physics/tileSweep.hpp"
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static bool IsCollidingAt(const World& world, float px, float py, float w, float h) {
+    int tileX0 = (int)floor(px / tileSize);
+    int tileY0 = (int)floor(py / tileSize);
+    int tileX1 = (int)floor((px + w - 0.01f) / tileSize);
+    int tileY1 = (int)floor((py + h - 0.01f) / tileSize);
+
+    for (int ty = tileY0; ty <= tileY1; ++ty) {
+        for (int tx = tileX0; tx <= tileX1; ++tx) {
+            if (world.IsSolidTile(tx, ty)) return true;
+        }
+    }
+    return false;
+}
+
+// The original Player::MoveY / Item::MoveY: tileSize / 4 steps, a full overlap test after each
+static float SubStepY(const World& world, float x, float y, float w, float h, float dy, bool& hit) {
+    float sign = dy > 0 ? 1.0f : -1.0f;
+    float step = tileSize / 4.0f;
+    float moved = 0.0f;
+
+    hit = false;
+    while (std::abs(moved) < std::abs(dy)) {
+        float move = std::min(step, std::abs(dy - moved)) * sign;
+        if (IsCollidingAt(world, x, y + moved + move, w, h)) {
+            hit = true;
+            break;
+        }
+        moved += move;
+    }
+    return moved;
+}
+
+struct Body {
+    float x, y, w, h;
+};
+
+struct Fall {
+    double ms = 0.0;
+    long long moves = 0;
+    std::vector<float> landedY;
+};
+
+// Drops every body at speed px/s in 60 Hz ticks until it lands
+template <typename Move>
+static Fall DropAll(const World& world, const std::vector<Body>& bodies, float speed, Move move) {
+    const float dy = speed / 60.0f;
+    Fall fall;
+    auto start = Clock::now();
+    for (const Body& body : bodies) {
+        float y = body.y;
+        bool hit = false;
+        while (!hit && y < world.getHeight() * tileSize) {
+            y += move(world, body.x, y, body.w, body.h, dy, hit);
+            ++fall.moves;
+        }
+        fall.landedY.push_back(y);
+    }
+    fall.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return fall;
+}
+
+int main(int argc, char** argv) {
+    int bodyCount = argc > 1 ? atoi(argv[1]) : 4000;
+    const float speeds[] = { 300.0f, 1000.0f, 3000.0f, 10000.0f }; // up to the materials' maxFallSpeed
+
+    World world(2023);
+    world.GenerateTerrain();
+
+    // Half players, half items, each starting 60 rows above the ground under it
+    std::mt19937 rng(11);
+    std::vector<Body> bodies;
+    for (int i = 0; i < bodyCount; ++i) {
+        float w = i % 2 ? 15.0f : 22.0f;
+        float h = i % 2 ? 15.0f : 44.0f;
+        float x = (float)(rng() % (world.getWidth() * tileSize - 64) + 16);
+        int ground = world.getHeight();
+        for (int tx = (int)(x / tileSize); tx <= (int)((x + w) / tileSize); ++tx) {
+            ground = std::min(ground, world.GetTopSolidY(tx));
+        }
+        bodies.push_back({ x, (float)(std::max(ground - 60, 0) * tileSize), w, h });
+    }
+
+    printf("%d bodies falling 60 rows or more, 60 Hz ticks\n\n", bodyCount);
+    printf("%10s %12s %16s %16s %10s\n", "px / s", "moves", "sub-step ns", "sweep ns", "speedup");
+    bool ok = true;
+    for (float speed : speeds) {
+        Fall old = DropAll(world, bodies, speed, SubStepY);
+        Fall swept = DropAll(world, bodies, speed, SweepY);
+
+        int misplaced = 0;
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            const Body& body = bodies[i];
+            float y = swept.landedY[i];
+            float bottom = y + body.h;
+            bool flush = std::fabs(bottom - std::round(bottom / tileSize) * tileSize) < 0.01f;
+            bool clear = !IsCollidingAt(world, body.x, y, body.w, body.h);
+            bool grounded = IsCollidingAt(world, body.x, y + 0.5f, body.w, body.h);
+            bool nearOld = y > old.landedY[i] - 0.01f && y - old.landedY[i] < tileSize / 4.0f;
+            misplaced += !(flush && clear && grounded && nearOld);
+        }
+        ok = ok && misplaced == 0;
+
+        double oldNs = old.ms * 1e6 / old.moves;
+        double sweptNs = swept.ms * 1e6 / swept.moves;
+        printf("%10.0f %12lld %16.1f %16.1f %9.1fx  %d misplaced %s\n", speed, swept.moves, oldNs, sweptNs,
+               oldNs / sweptNs, misplaced, misplaced == 0 ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+// Compresses every chunk of freshly generated worlds and reports the memory saved, tiles
+// and light together, the cost of expanding a chunk again and the cost of reading
+// through compression. Light is also reported on its own: as lit, where uniform chunks
+// already hold a single level, and once compressed with the tiles.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static int64_t ScanAll(const World& world) {
+    int64_t sum = 0;
+    for (int y = 0; y < world.getHeight(); ++y)
+        for (int x = 0; x < world.getWidth(); ++x)
+            sum += world.GetTile(x, y);
+    return sum;
+}
+
+static int64_t ScanLight(const World& world) {
+    int64_t sum = 0;
+    for (int y = 0; y < world.getHeight(); ++y)
+        for (int x = 0; x < world.getWidth(); ++x)
+            sum += world.GetSkyLight(x, y) * 16 + world.GetBlockLight(x, y);
+    return sum;
+}
+
+int main() {
+    const int worlds = 3;
+    printf("%-6s %10s %10s %8s %12s %14s %14s %20s %8s\n", "world", "raw KB", "packed KB", "ratio", "chunks",
+           "expand us/ch", "packed scan ms", "light KB lit/packed", "uniform");
+
+    for (int w = 0; w < worlds; ++w) {
+        World world;
+        world.GenerateTerrain();
+
+        auto start = Clock::now();
+        int64_t plainSum = ScanAll(world);
+        double plainScanMs = msSince(start);
+        int64_t plainLight = ScanLight(world);
+        size_t litLightBytes = world.GetCompressionStats().lightBytes;
+
+        int compressed = 0;
+        for (int cy = 0; cy < world.getChunksY(); ++cy)
+            for (int cx = 0; cx < world.getChunksX(); ++cx)
+                compressed += world.CompressChunk(cx, cy);
+        World::CompressionStats stats = world.GetCompressionStats();
+
+        start = Clock::now();
+        int64_t packedSum = ScanAll(world);
+        double packedScanMs = msSince(start);
+        int64_t packedLight = ScanLight(world);
+
+        start = Clock::now();
+        for (int cy = 0; cy < world.getChunksY(); ++cy)
+            for (int cx = 0; cx < world.getChunksX(); ++cx)
+                world.DecompressChunk(cx, cy);
+        double expandMs = msSince(start);
+
+        if (plainSum != packedSum || ScanAll(world) != plainSum) {
+            printf("world %d: compressed tiles read back differently\n", w);
+            return 1;
+        }
+        if (plainLight != packedLight || ScanLight(world) != plainLight) {
+            printf("world %d: compressed light reads back differently\n", w);
+            return 1;
+        }
+
+        printf("%-6d %10.1f %10.1f %7.1fx %5d/%-6d %14.2f %8.2f (%.2f) %9.1f / %-8.1f %8d\n", w,
+               stats.rawBytes / 1024.0, stats.residentBytes / 1024.0,
+               (double)stats.rawBytes / stats.residentBytes,
+               compressed, world.getChunksX() * world.getChunksY(),
+               expandMs * 1000.0 / compressed, packedScanMs, plainScanMs,
+               litLightBytes / 1024.0, stats.lightBytes / 1024.0, stats.uniformLightChunks);
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Runs a whole Game headless against the recording backend: waits out the loading
+// screen, then plays frames of Game::Update and Game::Draw with the player idle and
+// reports draw calls, texture binds, quads and overdraw per frame. Fails when a frame
+// breaks the bind budget or textures leak. Runs in a scratch directory so no save or
+// column cache of a real game is touched; textures load blank there, which counts the same.
+//
+// Usage: bench_draw [frames]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+#include "game/game.hpp"
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Totals {
+    double drawCalls = 0, textureBinds = 0, quads = 0, overdraw = 0, ms = 0;
+    int maxBinds = 0;
+};
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 600;
+    const int textureBindBudget = 24; // per frame, UI text and shapes included
+    const float deltaTime = 1.0f / 60.0f;
+
+    char scratch[] = "/tmp/bench_draw_XXXXXX";
+    if (!mkdtemp(scratch) || chdir(scratch) != 0) {
+        fprintf(stderr, "can't make a scratch directory\n");
+        return 2;
+    }
+
+    RecordingBackend recorder(windowWidth, windowHeight);
+    SetDrawBackend(&recorder);
+    std::cout.setstate(std::ios::failbit); // keep the game's progress logging out of the table
+
+    int exitCode = 0;
+    {
+        Game game;
+
+        int loadingFrames = 0;
+        auto start = Clock::now();
+        while (game.IsLoading()) {
+            game.Update(deltaTime);
+            recorder.BeginFrame();
+            game.Draw();
+            ++loadingFrames;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        double loadingMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        Totals totals;
+        for (int frame = 0; frame < frames; ++frame) {
+            game.Update(deltaTime);
+            recorder.BeginFrame();
+            auto drawStart = Clock::now();
+            game.Draw();
+            totals.ms += std::chrono::duration<double, std::milli>(Clock::now() - drawStart).count();
+
+            const RecordingBackend::FrameStats& stats = recorder.getFrameStats();
+            totals.drawCalls += stats.drawCalls;
+            totals.textureBinds += stats.textureBinds;
+            totals.quads += stats.quads;
+            totals.overdraw += recorder.getOverdraw();
+            totals.maxBinds = std::max(totals.maxBinds, stats.textureBinds);
+        }
+
+        bool bindsOk = totals.maxBinds <= textureBindBudget;
+        printf("%d x %d, %d loading frames (%.0f ms), %d frames measured\n\n", windowWidth, windowHeight,
+               loadingFrames, loadingMs, frames);
+        printf("%14s %14s %10s %10s %12s %12s\n", "draws / frame", "binds / frame", "max binds", "quads",
+               "overdraw", "cpu ms");
+        printf("%14.1f %14.1f %10d %10.1f %11.2fx %12.4f\n", totals.drawCalls / frames, totals.textureBinds / frames,
+               totals.maxBinds, totals.quads / frames, totals.overdraw / frames, totals.ms / frames);
+        printf("\ntexture binds within budget of %d: %s\n", textureBindBudget, bindsOk ? "ok" : "FAILED");
+
+        game.Destroy(); // its save lands in the scratch directory
+        bool leakOk = recorder.getLiveTextures() == 0;
+        printf("textures left after Destroy: %d %s\n", recorder.getLiveTextures(), leakOk ? "ok" : "FAILED");
+        exitCode = bindsOk && leakOk ? 0 : 1;
+    }
+
+    std::filesystem::current_path("/");
+    std::filesystem::remove_all(scratch);
+    SetDrawBackend(nullptr);
+    return exitCode;
+}
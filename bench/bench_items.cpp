@@ -0,0 +1,102 @@
+// Draws a screen full of dropped items through ItemManager::Render and through the
+// per-item path it replaced (Item::RenderDropped in a loop, kept below), both into
+// the recording backend, and compares their cost. Also checks fastSin against sinf.
+//
+// Usage: bench_items [items]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "game/itemManager.hpp"
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+#include "util/utils.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// The original per-item draw: its own time sample and sinf for the hover, then a shadow and a sprite
+static void RenderDropped(const Item& item, float camX, float camY, TextureManager& textureManager) {
+    int slot = TextureManager::GetItemSlot(item.texture);
+    if (slot < 0) return;
+
+    float hover = sinf(GetTime() * Item::hoverSpeed + item.phaseOffset) * Item::hoverAmplitude;
+    Rectangle shadow, sprite;
+    TextureManager::GetDroppedItemRects(item.xPos, item.yPos, camX, camY, item.size, hover, shadow, sprite);
+    textureManager.BatchRect(shadow, BLACK);
+    textureManager.BatchSprite(slot, sprite);
+}
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    int itemCount = argc > 1 ? atoi(argv[1]) : 10000;
+    const int frames = 200;
+    bool ok = true;
+
+    float worstError = 0.0f;
+    for (float x = -10000.0f; x < 10000.0f; x += 0.01f) {
+        worstError = std::max(worstError, std::fabs(fastSin(x) - sinf(x)));
+    }
+    bool sinOk = worstError < 0.002f;
+    ok = ok && sinOk;
+    printf("fastSin worst error %.5f over [-1e4, 1e4] %s\n", worstError, sinOk ? "ok" : "FAILED");
+
+    RecordingBackend recorder(windowWidth, windowHeight);
+    SetDrawBackend(&recorder);
+    TextureManager textureManager;
+    textureManager.Load();
+
+    std::cout.setstate(std::ios::failbit); // CreateDroppedItem logs every id
+    PhysicsSystem physics;
+    ItemManager itemManager(physics);
+    for (int i = 0; i < itemCount; ++i) {
+        float x = 1.0f + (float)(i * 37 % (windowWidth - 20));
+        float y = 1.0f + (float)(i * 91 % (windowHeight - 20));
+        itemManager.CreateDroppedItem("Stone", x, y, 1, (Item::ItemRenderType)(i % 4));
+    }
+    std::cout.clear();
+
+    // The original ItemManager::Render: a time sample, sinf and two quads per item
+    double perItemMs = 0.0;
+    int perItemQuads = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        recorder.BeginFrame();
+        auto start = Clock::now();
+        textureManager.BeginBatch();
+        for (const Item& item : ItemManager::items) {
+            if (item.xPos < windowWidth && item.xPos > 0 && item.yPos > 0 && item.yPos < windowHeight) {
+                RenderDropped(item, 0.0f, 0.0f, textureManager);
+            }
+        }
+        textureManager.FlushBatch();
+        perItemMs += msSince(start);
+        perItemQuads = recorder.getFrameStats().quads;
+    }
+
+    double batchedMs = 0.0;
+    RecordingBackend::FrameStats batched;
+    for (int frame = 0; frame < frames; ++frame) {
+        recorder.BeginFrame();
+        auto start = Clock::now();
+        itemManager.Render(0.0f, 0.0f, textureManager);
+        batchedMs += msSince(start);
+        batched = recorder.getFrameStats();
+    }
+
+    printf("%d items on a %dx%d screen\n\n", itemCount, windowWidth, windowHeight);
+    printf("%-10s %10s %10s %14s\n", "path", "quads", "binds", "cpu ms / frame");
+    printf("%-10s %10d %10s %14.3f\n", "per item", perItemQuads, "", perItemMs / frames);
+    printf("%-10s %10d %10d %14.3f  (%.2fx)\n", "batched", batched.quads, batched.textureBinds, batchedMs / frames,
+           perItemMs / batchedMs);
+
+    bool drawsOk = batched.quads == perItemQuads && batched.textureBinds == 1;
+    ok = ok && drawsOk;
+    printf("\nsame quads, one texture bind: %s\n", drawsOk ? "ok" : "FAILED");
+
+    textureManager.Unload();
+    SetDrawBackend(nullptr);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+// Times the incremental light update SetTile runs, against relighting the whole window:
+// first a sample of random digs near the surface, then a constructed worst case, a sealed
+// shaft as wide as light spreads and as deep as the world, opened (and closed) at the top
+// by a single edit. After each part the incremental light must match a full relight.
+//
+// Usage: bench_lighting [edits]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::vector<uint8_t> LightSnapshot(const World& world) {
+    std::vector<uint8_t> light;
+    light.reserve((size_t)world.getWidth() * world.getHeight());
+    for (int y = 0; y < world.getHeight(); ++y) {
+        for (int x = 0; x < world.getWidth(); ++x) {
+            light.push_back((uint8_t)(world.GetSkyLight(x, y) << 4 | world.GetBlockLight(x, y)));
+        }
+    }
+    return light;
+}
+
+// Tiles whose incremental light differs from a relight from scratch
+static int CountLightMismatches(World& world) {
+    std::vector<uint8_t> incremental = LightSnapshot(world);
+    world.RelightAll();
+    std::vector<uint8_t> full = LightSnapshot(world);
+
+    int mismatches = 0;
+    for (size_t i = 0; i < full.size(); ++i) mismatches += incremental[i] != full[i];
+    return mismatches;
+}
+
+static bool Report(const char* what, int mismatches) {
+    printf("%s: %d tiles differ from a full relight %s\n", what, mismatches, mismatches == 0 ? "ok" : "FAILED");
+    return mismatches == 0;
+}
+
+int main(int argc, char** argv) {
+    int edits = argc > 1 ? atoi(argv[1]) : 2000;
+
+    World world(2023);
+    world.SetGenerationThreads(0);
+    world.GenerateTerrain();
+
+    auto start = Clock::now();
+    for (int cx = 0; cx < world.getChunksX(); ++cx) world.RelightColumn(cx);
+    double fullMs = msSince(start);
+    start = Clock::now();
+    world.RelightAll();
+    double fullParallelMs = msSince(start);
+    printf("full relight of %d x %d tiles: %.2f ms on one thread, %.2f ms on the pool\n\n", world.getWidth(),
+           world.getHeight(), fullMs, fullParallelMs);
+
+    // Digs within a few screens of the surface, where light actually changes
+    std::mt19937 rng(7);
+    std::vector<double> ms;
+    std::vector<int> tiles;
+    while ((int)ms.size() < edits) {
+        int x = rng() % world.getWidth();
+        int y = world.GetTopNonAirY(x) + rng() % 80;
+        if (y >= world.getHeight() || world.GetTile(x, y) == World::TILE_AIR) continue;
+
+        start = Clock::now();
+        world.SetTile(x, y, World::TILE_AIR);
+        ms.push_back(msSince(start));
+        tiles.push_back(world.getLastLightUpdateTiles());
+    }
+
+    std::vector<double> sortedMs = ms;
+    std::sort(sortedMs.begin(), sortedMs.end());
+    double meanMs = 0.0, meanTiles = 0.0;
+    for (size_t i = 0; i < ms.size(); ++i) {
+        meanMs += ms[i] / ms.size();
+        meanTiles += (double)tiles[i] / tiles.size();
+    }
+    printf("%-22s %10s %10s %10s %12s %12s\n", "edit", "mean ms", "p99 ms", "max ms", "mean tiles", "max tiles");
+    printf("%-22s %10.4f %10.4f %10.4f %12.1f %12d\n", "random digs", meanMs, sortedMs[sortedMs.size() * 99 / 100],
+           sortedMs.back(), meanTiles, *std::max_element(tiles.begin(), tiles.end()));
+    int randomMismatches = CountLightMismatches(world);
+
+    // A shaft 2 * maxLight + 1 wide is the most sky light one opening can feed: the sky
+    // falls the full depth and spreads to the walls on every row. Built with raw writes
+    // under a stone lid, relit from scratch, then opened by digging the lid's middle.
+    int center = world.getWidth() / 2;
+    int lidY = 200; // below the deepest surface
+    for (int y = 0; y < world.getHeight(); ++y) {
+        for (int x = center - World::maxLight - 1; x <= center + World::maxLight + 1; ++x) {
+            bool wall = std::abs(x - center) > World::maxLight;
+            if (y < lidY) {
+                world.at(x, y) = World::TILE_AIR;
+            } else {
+                world.at(x, y) = y == lidY || wall ? World::TILE_STONE : World::TILE_AIR;
+            }
+        }
+    }
+    world.RelightAll();
+
+    double worstMs[2];
+    int worstTiles[2];
+    int shaftMismatches[2];
+    for (int step = 0; step < 2; ++step) {
+        start = Clock::now();
+        world.SetTile(center, lidY, step == 0 ? World::TILE_AIR : World::TILE_STONE);
+        worstMs[step] = msSince(start);
+        worstTiles[step] = world.getLastLightUpdateTiles();
+        printf("%-22s %10.4f %10s %10s %12d\n", step == 0 ? "open sealed shaft" : "close it again", worstMs[step],
+               "", "", worstTiles[step]);
+        shaftMismatches[step] = CountLightMismatches(world);
+    }
+
+    printf("\n");
+    bool ok = Report("after the random digs", randomMismatches);
+    ok = Report("after opening the shaft", shaftMismatches[0]) && ok;
+    ok = Report("after closing it", shaftMismatches[1]) && ok;
+
+    double worst = std::max(worstMs[0], worstMs[1]);
+    printf("\nworst single edit: %.3f ms, %.1fx cheaper than a full relight on one thread\n", worst, fullMs / worst);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+// Scatters items in the air across the whole world and lets them fall, once with the
+// whole world on screen, so every item runs at full rate, and once with a normal screen
+// in the middle, so items off it take coarse ticks or are suspended. Times the item side
+// of the ticks while they fall. Items near the screen must land where they would at full
+// rate; then the camera pans over the rest of the world, and every suspended item must
+// settle there too instead of staying frozen in the air.
+//
+// Usage: bench_lod [items]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "itemScene.hpp"
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    int itemCount = argc > 1 ? atoi(argv[1]) : 20000;
+    const int fallTicks = 240;
+
+    std::cout.setstate(std::ios::failbit); // CreateDroppedItem logs every id
+    World world(2023);
+    world.GenerateTerrain();
+    int worldWidth = world.getWidth() * tileSize;
+    int worldHeight = world.getHeight() * tileSize;
+
+    // Straight drops from up to 60 rows above the ground under each item
+    std::mt19937 rng(9);
+    std::vector<float> startX, startY;
+    int topSurface = world.getHeight(), bottomSurface = 0;
+    for (int i = 0; i < itemCount; ++i) {
+        int column = rng() % (world.getWidth() - 2);
+        int ground = std::min(world.GetTopSolidY(column), world.GetTopSolidY(column + 1));
+        topSurface = std::min(topSurface, ground);
+        bottomSurface = std::max(bottomSurface, ground);
+        startX.push_back((float)(column * tileSize));
+        startY.push_back((float)(std::max(ground - 2 - (int)(rng() % 60), 0) * tileSize));
+    }
+    auto dropAll = [&](ItemScene& scene) {
+        scene.itemManager.SetStacking(false); // every item stays its own, to compare where each landed
+        for (int i = 0; i < itemCount; ++i) {
+            scene.itemManager.CreateDroppedItem("Stone", startX[i], startY[i], 1, Item::BLOCK_STONE);
+        }
+    };
+
+    // Everything on screen, everything at full rate, until all of it is asleep
+    RecordingBackend wholeWorld(worldWidth, worldHeight);
+    SetDrawBackend(&wholeWorld);
+    std::vector<float> fullY;
+    double fullMs;
+    {
+        ItemScene scene(world);
+        dropAll(scene);
+        auto start = Clock::now();
+        for (int tick = 0; tick < fallTicks; ++tick) scene.Tick(0, 0);
+        fullMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / fallTicks;
+        for (int tick = 0; tick < 1200 && scene.physics.getAwakeCount() > 0; ++tick) scene.Tick(0, 0);
+        for (const Item& item : ItemManager::items) fullY.push_back(item.yPos);
+    }
+
+    // A normal screen over the middle of the surface
+    RecordingBackend screen(windowWidth, windowHeight);
+    SetDrawBackend(&screen);
+    ItemScene scene(world);
+    dropAll(scene);
+    int camX = worldWidth / 2 - windowWidth / 2;
+    int camY = world.GetTopSolidY(world.getWidth() / 2) * tileSize - windowHeight / 2;
+    scene.Tick(camX, camY);
+
+    int near = 0, coarse = 0;
+    for (int i = 0; i < scene.physics.getAwakeCount(); ++i) {
+        uint8_t flags = scene.physics.flags[i];
+        near += (flags & PhysicsSystem::BODY_ACTIVE) && !(flags & PhysicsSystem::BODY_COARSE);
+        coarse += (flags & PhysicsSystem::BODY_COARSE) != 0;
+    }
+    int suspended = itemCount - scene.physics.getAwakeCount();
+
+    auto start = Clock::now();
+    for (int tick = 1; tick < fallTicks; ++tick) scene.Tick(camX, camY);
+    double tieredMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / (fallTicks - 1);
+
+    // Landed in range: those the screen kept simulating must be where full rate put them
+    auto countMisplaced = [&](bool inRangeOnly) {
+        int misplaced = 0;
+        for (size_t i = 0; i < ItemManager::items.size(); ++i) {
+            const Item& item = ItemManager::items[i];
+            int index = scene.physics.IndexOf(item.body);
+            if (inRangeOnly && (scene.physics.flags[index] & PhysicsSystem::BODY_SUSPENDED)) continue;
+            misplaced += std::fabs(item.yPos - fullY[i]) > 0.01f;
+        }
+        return misplaced;
+    };
+    int misplacedInRange = countMisplaced(true);
+
+    // Pan over the whole surface band, a few ticks per screen
+    for (int y = topSurface * tileSize - windowHeight; y < bottomSurface * tileSize + windowHeight; y += windowHeight) {
+        for (int x = 0; x < worldWidth; x += windowWidth) {
+            for (int tick = 0; tick < 8; ++tick) scene.Tick(x, y);
+        }
+    }
+    int stillSuspended = 0;
+    for (const Item& item : ItemManager::items) {
+        int index = scene.physics.IndexOf(item.body);
+        stillSuspended += (scene.physics.flags[index] & PhysicsSystem::BODY_SUSPENDED) != 0;
+    }
+    int misplacedAfterPan = countMisplaced(false);
+
+    printf("%d items dropped across a %d x %d px world\n\n", itemCount, worldWidth, worldHeight);
+    printf("%-22s %10s %10s %10s %14s\n", "", "full rate", "coarse", "suspended", "ms / tick");
+    printf("%-22s %10d %10d %10d %14.3f\n", "whole world on screen", itemCount, 0, 0, fullMs);
+    printf("%-22s %10d %10d %10d %14.3f  (%.1fx)\n", "one screen, tiered", near, coarse, suspended, tieredMs,
+           fullMs / tieredMs);
+
+    bool rangeOk = misplacedInRange == 0;
+    bool panOk = stillSuspended == 0 && misplacedAfterPan == 0;
+    printf("\nlanded like full rate near the screen: %d differ %s\n", misplacedInRange, rangeOk ? "ok" : "FAILED");
+    printf("settled like full rate after the pan: %d differ, %d never resumed %s\n", misplacedAfterPan,
+           stillSuspended, panOk ? "ok" : "FAILED");
+
+    SetDrawBackend(nullptr);
+    return rangeOk && panOk ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// Steps a shower of dropped items through PhysicsSystem and through the per-item update
+// it replaced (Item::UpdateDropped without the pull toward the player, reproduced below
+// on Items carrying their own gravity and friction again), at a range of body counts.
+// Items fall straight down from varied heights, so most of a run is falling and then
+// resting; both paths must leave every item in the same place.
+//
+// Usage: bench_physics [ticks]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "game/item.hpp"
+#include "physics/physicsSystem.hpp"
+#include "physics/tileSweep.hpp"
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// An Item as it was, with its physics settings in every copy
+struct OldItem {
+    Item item;
+    float speed = 300.0f;
+    float friction = 350.0f;
+    float gravity = 1200.0f;
+    float maxFallSpeed = 10000.0f;
+};
+
+static void OldUpdateDropped(OldItem& old, float deltaTime, const World& world) {
+    Item& item = old.item;
+    item.vy += old.gravity * deltaTime;
+    if (item.vy > old.maxFallSpeed) item.vy = old.maxFallSpeed;
+
+    bool hit;
+    item.xPos += SweepX(world, item.xPos, item.yPos, item.size, item.size, item.vx * deltaTime, hit);
+    if (hit) item.vx = 0;
+    item.yPos += SweepY(world, item.xPos, item.yPos, item.size, item.size, item.vy * deltaTime, hit);
+    if (hit) item.vy = 0;
+
+    if (item.vx > 0.0f) {
+        item.vx -= old.friction * deltaTime;
+    } else if (item.vx < 0.0f) {
+        item.vx += old.friction * deltaTime;
+    }
+    if (item.vy > 0.0f) {
+        item.vy -= old.friction * deltaTime;
+    } else if (item.vy < 0.0f) {
+        item.vy += old.friction * deltaTime;
+    }
+}
+
+int main(int argc, char** argv) {
+    int ticks = argc > 1 ? atoi(argv[1]) : 240;
+    const float deltaTime = 1.0f / 60.0f;
+    const int bodyCounts[] = { 1000, 10000, 50000 };
+
+    World world(2023);
+    world.GenerateTerrain();
+
+    printf("%d ticks at 60 Hz, Item is %zu bytes\n\n", ticks, sizeof(Item));
+    printf("%10s %18s %18s %10s\n", "bodies", "per item ns/body", "system ns/body", "speedup");
+    bool ok = true;
+    for (int bodyCount : bodyCounts) {
+        std::mt19937 rng(5);
+        std::vector<OldItem> oldItems(bodyCount);
+        PhysicsSystem physics;
+        for (OldItem& old : oldItems) {
+            Item& item = old.item;
+            item.xPos = (float)(rng() % (world.getWidth() * tileSize - 64) + 16);
+            int ground = std::min(world.GetTopSolidY((int)(item.xPos / tileSize)),
+                                  world.GetTopSolidY((int)((item.xPos + item.size) / tileSize)));
+            item.yPos = (float)(std::max(ground - 2 - (int)(rng() % 40), 0) * tileSize);
+
+            PhysicsSystem::BodyId body =
+                physics.Add(item.xPos, item.yPos, item.size, item.size, PhysicsSystem::MATERIAL_ITEM);
+            physics.flags[physics.IndexOf(body)] |= PhysicsSystem::BODY_ACTIVE;
+        }
+
+        auto start = Clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            for (OldItem& old : oldItems) OldUpdateDropped(old, deltaTime, world);
+        }
+        double oldMs = msSince(start);
+
+        start = Clock::now();
+        for (int tick = 0; tick < ticks; ++tick) physics.Step(deltaTime, world);
+        double systemMs = msSince(start);
+
+        // Bodies were added in order and never removed, so index i is item i
+        int moved = 0;
+        for (int i = 0; i < bodyCount; ++i) {
+            const Item& item = oldItems[i].item;
+            moved += std::fabs(physics.x[i] - item.xPos) > 0.001f || std::fabs(physics.y[i] - item.yPos) > 0.001f;
+        }
+        ok = ok && moved == 0;
+
+        double oldNs = oldMs * 1e6 / ((double)ticks * bodyCount);
+        double systemNs = systemMs * 1e6 / ((double)ticks * bodyCount);
+        printf("%10d %18.1f %18.1f %9.2fx  %d differ %s\n", bodyCount, oldNs, systemNs, oldNs / systemNs, moved,
+               moved == 0 ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+// Pans a camera across a generated world and counts the draw calls World::Render issues
+// through the recording backend, next to the per-tile loop it replaced (reproduced below).
+// Also checks that a still camera bakes nothing and that an edit rebakes one chunk.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// The original World::Render: one draw per visible non-air tile, every tile tested for culling
+static int PerTileDraws(const World& world, int camX, int camY, int screenWidth, int screenHeight) {
+    int draws = 0;
+    for (int y = 0; y < world.getHeight(); ++y) {
+        int tilePixelY = y * tileSize;
+        if ((tilePixelY + tileSize) <= camY || tilePixelY >= camY + screenHeight) continue;
+
+        for (int x = 0; x < world.getWidth(); ++x) {
+            int tilePixelX = x * tileSize;
+            if ((tilePixelX + tileSize) <= camX || tilePixelX >= camX + screenWidth) continue;
+            if (World::GetTileInfo(world.GetTile(x, y)).textureSlot >= 0) ++draws;
+        }
+    }
+    return draws;
+}
+
+int main() {
+    const int frames = 2000;
+    const int screenWidth = windowWidth;
+    const int screenHeight = windowHeight;
+
+    World world(2023);
+    world.SetGenerationThreads(0);
+    world.GenerateTerrain();
+
+    RecordingBackend recorder(screenWidth, screenHeight);
+    SetDrawBackend(&recorder);
+    TextureManager textureManager;
+    textureManager.Load();
+    const ChunkRenderCache& cache = world.getRenderCache();
+
+    // Camera path: down from the surface and back up while drifting right, a few pixels a frame
+    int maxCamX = world.getWidth() * tileSize - screenWidth;
+    int maxCamY = world.getHeight() * tileSize - screenHeight;
+    auto cameraAt = [&](int frame, int& camX, int& camY) {
+        camX = std::min(maxCamX, frame * 3);
+        int depth = (frame * 5) % (2 * 3000);
+        camY = std::min(maxCamY, 600 * tileSize / 2 + (depth < 3000 ? depth : 6000 - depth));
+    };
+
+    long long chunkDraws = 0, bakes = 0, tileDraws = 0;
+    double chunkMs = 0.0, tileMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame) {
+        int camX, camY;
+        cameraAt(frame, camX, camY);
+
+        recorder.BeginFrame();
+        auto start = Clock::now();
+        world.Render(camX, camY, screenWidth, screenHeight, textureManager);
+        chunkMs += msSince(start);
+        chunkDraws += recorder.getFrameStats().drawCalls;
+        bakes += cache.getFrameStats().chunksBaked;
+
+        start = Clock::now();
+        tileDraws += PerTileDraws(world, camX, camY, screenWidth, screenHeight);
+        tileMs += msSince(start);
+    }
+
+    printf("%d frames at %dx%d, %d px chunks, %d chunks cached\n\n", frames, screenWidth, screenHeight,
+           chunkSize * tileSize, cache.getCachedChunks());
+    printf("%-12s %16s %16s %12s\n", "renderer", "draws / frame", "bakes / frame", "cpu ms / frame");
+    printf("%-12s %16.1f %16.3f %12.4f\n", "per tile", (double)tileDraws / frames, 0.0, tileMs / frames);
+    printf("%-12s %16.1f %16.3f %12.4f\n", "chunk cache", (double)chunkDraws / frames, (double)bakes / frames,
+           chunkMs / frames);
+
+    // A still camera draws from the cache alone
+    int camX = world.getWidth() * tileSize / 2;
+    int camY = 600 * tileSize / 2;
+    world.Render(camX, camY, screenWidth, screenHeight, textureManager);
+    recorder.BeginFrame();
+    world.Render(camX, camY, screenWidth, screenHeight, textureManager);
+    RecordingBackend::FrameStats still = recorder.getFrameStats();
+    bool stillOk = cache.getFrameStats().chunksBaked == 0 && still.drawCalls == cache.getFrameStats().chunksDrawn;
+    printf("\nstill camera: %d draws, %d binds, %.2fx overdraw, %d bakes %s\n", still.drawCalls, still.textureBinds,
+           recorder.getOverdraw(), cache.getFrameStats().chunksBaked, stillOk ? "ok" : "FAILED");
+
+    // Digging one tile on screen rebakes exactly its chunk
+    int tileX = (camX + screenWidth / 2) / tileSize;
+    int tileY = camY / tileSize;
+    while (tileY < (camY + screenHeight) / tileSize && world.GetTile(tileX, tileY) == World::TILE_AIR) ++tileY;
+    world.SetTile(tileX, tileY, World::TILE_AIR);
+    recorder.BeginFrame();
+    world.Render(camX, camY, screenWidth, screenHeight, textureManager);
+    RecordingBackend::FrameStats edited = recorder.getFrameStats();
+    int tilesBaked = edited.quads - cache.getFrameStats().chunksDrawn;
+    bool editOk = cache.getFrameStats().chunksBaked == 1 && tilesBaked <= chunkArea;
+    printf("after an edit: %d bakes, %d tiles baked %s\n", cache.getFrameStats().chunksBaked, tilesBaked,
+           editOk ? "ok" : "FAILED");
+
+    // Zoomed far out there are more chunks on screen than the cache holds: it stays at its
+    // cap, keeps the chunks it has, and the rest are drawn tile by tile
+    int wideWidth = screenWidth * 5;
+    int wideHeight = screenHeight * 5;
+    int deepY = world.getHeight() * tileSize / 2;
+    for (int frame = 0; frame < 3; ++frame) {
+        recorder.BeginFrame();
+        world.Render(camX, deepY, wideWidth, wideHeight, textureManager);
+    }
+    const ChunkRenderCache::FrameStats& wide = cache.getFrameStats();
+    const int cap = ChunkRenderCache::maxEntries;
+    bool capOk = cache.getCachedChunks() == cap && wide.chunksDrawn == cap && wide.chunksUncached > 0 &&
+                 wide.chunksBaked == 0;
+    printf("zoomed out: %d chunks cached, %d drawn from the cache, %d without, %d bakes %s\n", cache.getCachedChunks(),
+           wide.chunksDrawn, wide.chunksUncached, wide.chunksBaked, capOk ? "ok" : "FAILED");
+
+    world.getRenderCache().Unload();
+    textureManager.Unload();
+    bool leakOk = recorder.getLiveTextures() == 0;
+    printf("textures left after unloading: %d %s\n", recorder.getLiveTextures(), leakOk ? "ok" : "FAILED");
+
+    SetDrawBackend(nullptr);
+    return stillOk && editOk && capOk && leakOk ? 0 : 1;
+}
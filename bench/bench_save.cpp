@@ -0,0 +1,184 @@
+// Times a full terrain generation against saving and mapping the world back in, and
+// checks the loaded world, player and items match what was saved, down to the light and
+// the surface and occupancy indexes the save carries so that loading reads no tiles.
+// Loading is timed on its own, then the first pass over every tile and light level of
+// the loaded world, which is where the mapped pages are actually read in. Then damages
+// copies of the save, each of which must be turned away rather than read past its end.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "game/itemManager.hpp"
+#include "game/saveManager.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool SameTiles(const World& a, const World& b) {
+    for (int y = 0; y < a.getHeight(); ++y)
+        for (int x = 0; x < a.getWidth(); ++x)
+            if (a.GetTile(x, y) != b.GetTile(x, y)) return false;
+    return true;
+}
+
+static bool SameIndexesAndLight(const World& a, const World& b) {
+    for (int x = 0; x < a.getWidth(); ++x) {
+        if (a.GetTopSolidY(x) != b.GetTopSolidY(x) || a.GetTopNonAirY(x) != b.GetTopNonAirY(x)) return false;
+        for (int y = 0; y < a.getHeight(); y += chunkSize) {
+            int y1 = std::min(y + chunkSize, a.getHeight()) - 1;
+            if (a.AnySolid(x, y, x, y1) != b.AnySolid(x, y, x, y1) || a.IsAllAir(x, y, x, y1) != b.IsAllAir(x, y, x, y1))
+                return false;
+        }
+    }
+    for (int y = 0; y < a.getHeight(); ++y)
+        for (int x = 0; x < a.getWidth(); ++x)
+            if (a.GetSkyLight(x, y) != b.GetSkyLight(x, y) || a.GetBlockLight(x, y) != b.GetBlockLight(x, y)) return false;
+    return true;
+}
+
+// Touches every tile and light level once
+static int64_t ReadAll(const World& world) {
+    int64_t sum = 0;
+    for (int y = 0; y < world.getHeight(); ++y)
+        for (int x = 0; x < world.getWidth(); ++x)
+            sum += world.GetTile(x, y) + world.GetLight(x, y);
+    return sum;
+}
+
+// Byte offsets of SaveHeader fields, as saveManager.cpp lays the header out
+static constexpr size_t itemCountAt = 40;
+static constexpr size_t lightBlocksAt = 48;
+static constexpr size_t indexOffsetAt = 88;
+static constexpr size_t tilesOffsetAt = 104;
+static constexpr size_t fileSizeAt = 112;
+
+template <typename T>
+static T Peek(const std::vector<char>& bytes, size_t at) {
+    T value;
+    std::memcpy(&value, bytes.data() + at, sizeof(value));
+    return value;
+}
+
+template <typename T>
+static void Patch(std::vector<char>& bytes, size_t at, T value) {
+    std::memcpy(bytes.data() + at, &value, sizeof(value));
+}
+
+// Whether a save damaged by damage is refused
+template <typename Damage>
+static bool Refused(const std::string& path, const std::vector<char>& saved, Damage damage) {
+    std::vector<char> bytes = saved;
+    damage(bytes);
+    std::string badPath = path + ".bad";
+    std::ofstream(badPath, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+
+    World world;
+    Player player;
+    Inventory inventory;
+    bool loaded = SaveManager(badPath).Load(world, player, inventory);
+    std::remove(badPath.c_str());
+    return !loaded;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "build/bench_save.sav";
+    SaveManager saveManager(path);
+
+    World world;
+    auto start = Clock::now();
+    world.GenerateTerrain();
+    double generateMs = msSince(start);
+
+    Player player;
+    player.Init(world);
+    player.health = 42;
+    Inventory inventory;
+    for (int i = 0; i < 1000; ++i) {
+        Item item;
+        std::snprintf(item.name, sizeof(item.name), "Stone");
+        item.xPos = i * 3.0f;
+        item.yPos = 100.0f + i;
+        item.location = Item::DROPPED;
+        item.texture = Item::BLOCK_STONE;
+        item.id = 1000 + i;
+        if (i % 4 == 0) {
+            inventory.AddItemToInventory(item);
+        } else {
+            ItemManager::AddItemToWorld(std::move(item));
+        }
+    }
+    world.at(10, 300) = World::TILE_STONE;
+    size_t savedItems = ItemManager::items.size();
+
+    start = Clock::now();
+    if (!saveManager.Save(world, player, inventory)) return 1;
+    double saveMs = msSince(start);
+
+    const int loads = 20;
+    double loadMs = 0.0;
+    double firstReadMs = 0.0;
+    int64_t checksum = 0;
+    bool roundTrip = true;
+    for (int i = 0; i < loads; ++i) {
+        World loaded;
+        Player loadedPlayer;
+        Inventory loadedInventory;
+
+        start = Clock::now();
+        if (!saveManager.Load(loaded, loadedPlayer, loadedInventory)) return 1;
+        loadMs += msSince(start);
+
+        start = Clock::now();
+        checksum += ReadAll(loaded);
+        firstReadMs += msSince(start);
+
+        if (i == 0) {
+            roundTrip = SameTiles(world, loaded) && SameIndexesAndLight(world, loaded) &&
+                        loaded.getSeed() == world.getSeed() &&
+                        loadedPlayer.x == player.x && loadedPlayer.y == player.y &&
+                        loadedPlayer.health == player.health &&
+                        ItemManager::items.size() == savedItems &&
+                        loadedInventory.inventory.size() == inventory.inventory.size() &&
+                        loadedInventory.currentWeight == inventory.currentWeight &&
+                        std::strcmp(ItemManager::items.back().name, "Stone") == 0;
+        }
+    }
+
+    // Damaged copies: counts and offsets past the end, a file cut short whose header was
+    // patched to agree with its new size, a tile past the tile table and a surface row past
+    // the bottom of the world
+    std::ifstream savedFile(path, std::ios::binary);
+    std::vector<char> saved((std::istreambuf_iterator<char>(savedFile)), std::istreambuf_iterator<char>());
+    bool rejected =
+        Refused(path, saved, [](std::vector<char>& bytes) { Patch<uint32_t>(bytes, itemCountAt, 0xFFFFFFFFu); }) &&
+        Refused(path, saved, [](std::vector<char>& bytes) { Patch<uint64_t>(bytes, tilesOffsetAt, bytes.size()); }) &&
+        Refused(path, saved, [](std::vector<char>& bytes) { Patch<uint32_t>(bytes, lightBlocksAt, 0); }) &&
+        Refused(path, saved, [](std::vector<char>& bytes) {
+            bytes.resize(bytes.size() / 2);
+            Patch<uint64_t>(bytes, fileSizeAt, bytes.size());
+        }) &&
+        Refused(path, saved, [](std::vector<char>& bytes) {
+            size_t tiles = Peek<uint64_t>(bytes, tilesOffsetAt);
+            Patch<uint8_t>(bytes, tiles + (bytes.size() - tiles) / 2, World::TILE_COUNT);
+        }) &&
+        Refused(path, saved, [&](std::vector<char>& bytes) {
+            Patch<int32_t>(bytes, Peek<uint64_t>(bytes, indexOffsetAt) + 5 * sizeof(int32_t), world.getHeight());
+        });
+
+    printf("generate   %8.2f ms\n", generateMs);
+    printf("save       %8.2f ms\n", saveMs);
+    printf("load       %8.3f ms (mean of %d), maps tiles and light, checks the tiles, copies the indexes\n", loadMs / loads, loads);
+    printf("first read %8.3f ms, every tile and light level of the loaded world (checksum %lld)\n",
+           firstReadMs / loads, (long long)(checksum / loads));
+    printf("round trip %s\n", roundTrip ? "ok" : "MISMATCH");
+    printf("damaged saves refused: %s\n", rejected ? "ok" : "FAILED");
+    return roundTrip && rejected ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// Drops a screen full of items onto the ground and times the item side of a tick once
+// they have all landed, with resting items put to sleep and without. Sleeping should
+// leave the steady state costing next to nothing and every item where it would have
+// landed anyway. Then checks both ways of waking: digging out the tile under a sleeper
+// drops it, and the player walking up to one picks it up.
+//
+// Usage: bench_sleep [items]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "itemScene.hpp"
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static const Item* FindItem(uint64_t id) {
+    for (const Item& item : ItemManager::items) {
+        if (item.id == id) return &item;
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv) {
+    int itemCount = argc > 1 ? atoi(argv[1]) : 20000;
+    const int settleTicks = 300;
+    const int timedTicks = 200;
+
+    RecordingBackend recorder(windowWidth, windowHeight);
+    SetDrawBackend(&recorder);
+    std::cout.setstate(std::ios::failbit); // CreateDroppedItem logs every id
+
+    World world(2023);
+    world.GenerateTerrain();
+
+    // A screen over the surface around the middle, and the columns whose ground is on it
+    int firstColumn = world.getWidth() / 2 - windowWidth / tileSize / 2;
+    int highest = world.getHeight();
+    for (int x = firstColumn; x < firstColumn + windowWidth / tileSize; ++x) {
+        highest = std::min(highest, world.GetTopSolidY(x));
+    }
+    int camX = firstColumn * tileSize;
+    int camY = highest * tileSize - windowHeight / 3;
+    std::vector<int> columns;
+    for (int x = firstColumn + 1; x < firstColumn + windowWidth / tileSize - 2; ++x) {
+        if (world.GetTopSolidY(x) * tileSize < camY + windowHeight - tileSize) columns.push_back(x);
+    }
+
+    double tickMs[2];
+    std::vector<float> restingY[2];
+    int awake[2];
+    for (int sleeping = 0; sleeping < 2; ++sleeping) {
+        ItemScene scene(world, camX, camY);
+        scene.itemManager.SetStacking(false); // every item stays its own, to compare where each landed
+        scene.itemManager.SetSleeping(sleeping);
+        std::mt19937 rng(3);
+        for (int i = 0; i < itemCount; ++i) {
+            int x = columns[rng() % columns.size()];
+            float y = camY + 1.0f + rng() % (world.GetTopSolidY(x) * tileSize - camY - 2 * tileSize);
+            scene.itemManager.CreateDroppedItem("Stone", x * tileSize, y, 1, Item::BLOCK_STONE);
+        }
+
+        for (int tick = 0; tick < settleTicks; ++tick) scene.Tick();
+        auto start = Clock::now();
+        for (int tick = 0; tick < timedTicks; ++tick) scene.Tick();
+        tickMs[sleeping] = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / timedTicks;
+        awake[sleeping] = scene.physics.getAwakeCount();
+        for (const Item& item : ItemManager::items) restingY[sleeping].push_back(item.yPos);
+    }
+
+    printf("%d items landed on one screen, item tick after %d ticks\n\n", itemCount, settleTicks);
+    printf("%-16s %12s %12s\n", "", "awake", "ms / tick");
+    printf("%-16s %12d %12.4f\n", "always awake", awake[0], tickMs[0]);
+    printf("%-16s %12d %12.4f  (%.0fx)\n", "sleeping", awake[1], tickMs[1], tickMs[0] / tickMs[1]);
+
+    int moved = 0;
+    for (size_t i = 0; i < restingY[0].size(); ++i) moved += restingY[0][i] != restingY[1][i];
+    bool sleptOk = awake[1] == 0;
+    bool restOk = moved == 0;
+    printf("\nall asleep once landed: %s\n", sleptOk ? "ok" : "FAILED");
+    printf("same resting places either way: %d differ %s\n", moved, restOk ? "ok" : "FAILED");
+
+    // Waking: dig out the ground under one sleeper, walk the player up to another
+    ItemScene scene(world, camX, camY);
+    scene.itemManager.SetStacking(false);
+    scene.itemManager.CreateDroppedItem("Stone", columns[0] * tileSize, camY + 1.0f, 1, Item::BLOCK_STONE);
+    scene.itemManager.CreateDroppedItem("Stone", columns.back() * tileSize, camY + 1.0f, 1, Item::BLOCK_STONE);
+    uint64_t dugId = ItemManager::items[0].id;
+    uint64_t walkedId = ItemManager::items[1].id;
+    for (int tick = 0; tick < settleTicks; ++tick) scene.Tick();
+    bool bothAsleep = scene.physics.getAwakeCount() == 0;
+
+    const Item* dug = FindItem(dugId);
+    float restY = dug->yPos;
+    int groundY = (int)std::round((dug->yPos + dug->size) / tileSize);
+    for (int x = (int)(dug->xPos / tileSize); x <= (int)((dug->xPos + dug->size) / tileSize); ++x) {
+        world.SetTile(x, groundY, World::TILE_AIR);
+        scene.itemManager.WakeItemsNear(x, groundY);
+    }
+    for (int tick = 0; tick < 30; ++tick) scene.Tick();
+    bool fell = FindItem(dugId)->yPos > restY;
+
+    const Item* walked = FindItem(walkedId);
+    scene.player.x = walked->xPos - tileSize / 2;
+    scene.player.y = walked->yPos - tileSize;
+    scene.Tick();
+    bool pickedUp = FindItem(walkedId) == nullptr;
+
+    bool wakeOk = bothAsleep && fell && pickedUp;
+    printf("asleep, then woken by a dig (fell %s) and by the player (picked up %s): %s\n", fell ? "yes" : "no",
+           pickedUp ? "yes" : "no", wakeOk ? "ok" : "FAILED");
+
+    SetDrawBackend(nullptr);
+    return sleptOk && restOk && wakeOk ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// Mines a pit out of the surface row by row through the block editor, so every tile
+// drops its item and the items already in the pit fall onto the next row. Done once with
+// items kept one per block and once with identical ones stacking as they come to rest;
+// times the ticks while digging and drawing the items once the pit is dug. Stacking must keep
+// every mined block, in far fewer items, and the player picking up a stack must get all
+// of it in one go, or only as much as the inventory has weight left for.
+//
+// Usage: bench_stacks [columns] [rows]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "itemScene.hpp"
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static int Units() {
+    int units = 0;
+    for (const Item& item : ItemManager::items) units += item.count;
+    return units;
+}
+
+int main(int argc, char** argv) {
+    int columns = argc > 1 ? atoi(argv[1]) : 60;
+    int rows = argc > 2 ? atoi(argv[2]) : 36;
+    const int ticksPerRow = 12;
+    const int renderFrames = 200;
+
+    RecordingBackend recorder(windowWidth, windowHeight);
+    SetDrawBackend(&recorder);
+    std::cout.setstate(std::ios::failbit); // CreateDroppedItem logs every id
+
+    // The pit and a screen over it, deep enough to keep all of it in view
+    World layout(2023);
+    layout.GenerateTerrain();
+    int firstColumn = layout.getWidth() / 2 - columns / 2;
+    int top = layout.getHeight();
+    for (int x = firstColumn; x < firstColumn + columns; ++x) top = std::min(top, layout.GetTopSolidY(x));
+    int camX = firstColumn * tileSize - tileSize * 4;
+    int camY = top * tileSize - tileSize * 4;
+
+    TextureManager textureManager;
+    int items[2], units[2], dropped[2], awake[2];
+    double tickMs[2], renderMs[2];
+    for (int stacking = 0; stacking < 2; ++stacking) {
+        World world(2023);
+        world.GenerateTerrain();
+        ItemScene scene(world, camX, camY);
+        scene.itemManager.SetStacking(stacking);
+        dropped[stacking] = 0;
+        auto start = Clock::now();
+        for (int y = top; y < top + rows; ++y) {
+            for (int x = firstColumn; x < firstColumn + columns; ++x) {
+                dropped[stacking] += scene.editor.MineTile(x, y, scene.itemManager);
+            }
+            for (int tick = 0; tick < ticksPerRow; ++tick) scene.Tick();
+        }
+        tickMs[stacking] = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / (rows * ticksPerRow);
+        for (int tick = 0; tick < 600 && scene.physics.getAwakeCount() > 0; ++tick) scene.Tick();
+        awake[stacking] = scene.physics.getAwakeCount();
+
+        start = Clock::now();
+        for (int frame = 0; frame < renderFrames; ++frame) {
+            recorder.BeginFrame();
+            scene.itemManager.Render(camX, camY, textureManager);
+        }
+        renderMs[stacking] = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / renderFrames;
+
+        items[stacking] = (int)ItemManager::items.size();
+        units[stacking] = Units();
+    }
+
+    printf("%d x %d tile pit mined row by row, %d blocks dropped\n\n", columns, rows, units[0]);
+    printf("%-16s %10s %10s %14s %14s\n", "", "items", "blocks", "dig tick ms", "render ms");
+    printf("%-16s %10d %10d %14.4f %14.4f\n", "one per block", items[0], units[0], tickMs[0], renderMs[0]);
+    printf("%-16s %10d %10d %14.4f %14.4f  (%.1fx fewer items)\n", "stacked", items[1], units[1], tickMs[1],
+           renderMs[1], (double)items[0] / items[1]);
+
+    bool keptOk = units[0] == dropped[0] && units[1] == dropped[1] && awake[0] == 0 && awake[1] == 0;
+    bool fewerOk = items[1] < items[0];
+    printf("\nevery block kept, all at rest: %s\n", keptOk ? "ok" : "FAILED");
+    printf("fewer items stacked: %s\n", fewerOk ? "ok" : "FAILED");
+
+    // The player walks up to the biggest stack and takes all of it at once
+    World world(2023);
+    world.GenerateTerrain();
+    ItemScene scene(world, camX, camY);
+    for (int y = top; y < top + 6; ++y) {
+        for (int x = firstColumn; x < firstColumn + 8; ++x) scene.editor.MineTile(x, y, scene.itemManager);
+        for (int tick = 0; tick < ticksPerRow; ++tick) scene.Tick();
+    }
+    for (int tick = 0; tick < 300; ++tick) scene.Tick();
+    size_t biggest = 0;
+    for (size_t slot = 0; slot < ItemManager::items.size(); ++slot) {
+        if (ItemManager::items[slot].count > ItemManager::items[biggest].count) biggest = slot;
+    }
+    Item stack = ItemManager::items[biggest];
+    size_t before = ItemManager::items.size();
+    scene.player.x = stack.xPos - tileSize / 2;
+    scene.player.y = stack.yPos - tileSize;
+    scene.Tick();
+
+    bool taken = ItemManager::items.size() == before - 1 && scene.inventory.inventory.size() == 1 &&
+                 scene.inventory.inventory[0].id == stack.id && scene.inventory.inventory[0].count == stack.count &&
+                 scene.inventory.currentWeight == stack.itemWeight * stack.count;
+    bool pickupOk = stack.count > 1 && taken;
+    printf("picked up a stack of %d whole: %s\n", stack.count, pickupOk ? "ok" : "FAILED");
+
+    // Then to the next biggest with room for only about half of it: that much comes in and
+    // the rest stays on the ground
+    biggest = 0;
+    for (size_t slot = 0; slot < ItemManager::items.size(); ++slot) {
+        if (ItemManager::items[slot].count > ItemManager::items[biggest].count) biggest = slot;
+    }
+    Item next = ItemManager::items[biggest];
+    int fits = next.count / 2;
+    float weightBefore = scene.inventory.currentWeight;
+    scene.inventory.maxWeight = weightBefore + next.itemWeight * (fits + 0.5f);
+    before = ItemManager::items.size();
+    scene.player.x = next.xPos - tileSize / 2;
+    scene.player.y = next.yPos - tileSize;
+    for (int tick = 0; tick < 30; ++tick) scene.Tick();
+
+    int left = 0;
+    for (const Item& item : ItemManager::items) left += item.id == next.id ? item.count : 0;
+    bool partialOk = next.count > 1 && fits > 0 && ItemManager::items.size() == before &&
+                     scene.inventory.inventory.size() == 2 && scene.inventory.inventory[1].count == fits &&
+                     scene.inventory.inventory[1].id != next.id && left == next.count - fits &&
+                     scene.inventory.currentWeight == weightBefore + next.itemWeight * fits &&
+                     scene.inventory.currentWeight <= scene.inventory.maxWeight;
+    printf("picked up %d of a stack of %d, rest left: %s\n", fits, next.count, partialOk ? "ok" : "FAILED");
+
+    SetDrawBackend(nullptr);
+    return keptOk && fewerOk && pickupOk && partialOk ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// Runs a headless Game at a range of frame rates and reports what a simulated second
+// costs at each: the fixed ticks run and the CPU time spent in Game::Update. Every run
+// starts with the same shower of dropped items on screen around the player, so the
+// ticks have physics to do. Fails when a frame rate the tick loop can keep up with runs
+// a different number of ticks per simulated second. Runs in a scratch directory like
+// bench_draw.
+//
+// Usage: bench_timestep [simulated seconds]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <unistd.h>
+#include "game/game.hpp"
+#include "render/recordingBackend.hpp"
+#include "util/globals.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    float seconds = argc > 1 ? (float)atof(argv[1]) : 5.0f;
+    const int ticksPerSecond = 60;
+    const int maxTicksPerFrame = 8; // Game's cap, below which frame rates fall behind
+    const int itemCount = 400;
+    const float frameRates[] = { 5, 20, 30, 60, 144, 240, 1000 };
+
+    char scratch[] = "/tmp/bench_timestep_XXXXXX";
+    if (!mkdtemp(scratch) || chdir(scratch) != 0) {
+        fprintf(stderr, "can't make a scratch directory\n");
+        return 2;
+    }
+
+    RecordingBackend recorder(windowWidth, windowHeight);
+    SetDrawBackend(&recorder);
+    std::cout.setstate(std::ios::failbit); // keep the game's progress logging out of the table
+
+    bool ok = true;
+    {
+        Game game;
+        while (game.IsLoading()) {
+            game.Update(1.0f / ticksPerSecond);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        game.Update(1.0f / ticksPerSecond); // past the first tick, so the player is placed
+        const Player& player = game.getPlayer();
+        ItemManager& itemManager = game.getItemManager();
+
+        printf("%d dropped items per run, %.1f simulated seconds\n\n", itemCount, seconds);
+        printf("%8s %10s %10s %14s %18s\n", "fps", "frames", "ticks", "ticks / sim s", "update ms / sim s");
+        for (float fps : frameRates) {
+            itemManager.Clear();
+            for (int i = 0; i < itemCount; ++i) {
+                float x = player.x + (i % 40 - 20) * 25.0f;
+                float y = player.y - 300.0f + (i / 40) * 20.0f;
+                itemManager.CreateDroppedItem("Stone", x, y, 1, Item::BLOCK_STONE);
+            }
+
+            int frames = (int)std::lround(seconds * fps);
+            int ticks = 0;
+            auto start = Clock::now();
+            for (int frame = 0; frame < frames; ++frame) {
+                ticks += game.Update(1.0f / fps);
+            }
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            // Frame rates too low for the cap fall behind by design
+            bool keepsUp = fps * maxTicksPerFrame >= ticksPerSecond;
+            int expected = (int)std::lround(seconds * ticksPerSecond);
+            bool runOk = !keepsUp || std::abs(ticks - expected) <= 1;
+            ok = ok && runOk;
+            printf("%8.0f %10d %10d %14.1f %18.3f %s\n", fps, frames, ticks, ticks / seconds, ms / seconds,
+                   keepsUp ? (runOk ? "ok" : "FAILED") : "(capped)");
+        }
+        itemManager.Clear();
+        game.Destroy();
+    }
+
+    std::filesystem::current_path("/");
+    std::filesystem::remove_all(scratch);
+    SetDrawBackend(nullptr);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+// Headless generation baseline: runs World::GenerateTerrain over a matrix of seeds and
+// world sizes and prints JSON with per-pass timings, peak RSS and tiles per second.
+// Links only src/world, src/render and src/util (see the Makefile).
+//
+// Usage: bench_worldgen [--seeds=1,2,3] [--sizes=800x2000,1600x2000] [--threads=N]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Size {
+    int width;
+    int height;
+};
+
+static std::vector<std::string> SplitList(const char* text) {
+    std::vector<std::string> items;
+    std::string item;
+    for (const char* c = text; ; ++c) {
+        if (*c == ',' || *c == '\0') {
+            if (!item.empty()) items.push_back(item);
+            item.clear();
+            if (*c == '\0') break;
+        } else {
+            item += *c;
+        }
+    }
+    return items;
+}
+
+// One configuration as a JSON object. Runs in a forked child so peak RSS belongs to it alone.
+static std::string RunOne(unsigned int seed, Size size, unsigned int threads) {
+    std::cout.setstate(std::ios::failbit); // World logs progress on cout; stdout stays pure JSON
+
+    auto start = Clock::now();
+    World world(seed, size.width, size.height);
+    world.SetGenerationThreads(threads);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency()); // what the pool picked
+    world.GenerateTerrain();
+    double wallMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    double tiles = (double)size.width * size.height;
+
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer),
+             "    {\"seed\": %u, \"width\": %d, \"height\": %d, \"threads\": %u, \"wall_ms\": %.3f, "
+             "\"pipeline_ms\": %.3f, \"tiles_per_second\": %.0f, \"peak_rss_kb\": %ld, \"hash\": \"%016llx\",\n"
+             "     \"passes\": [",
+             seed, size.width, size.height, threads, wallMs, world.getGenerationPipeline().getWallMs(),
+             tiles / (wallMs / 1000.0), usage.ru_maxrss, (unsigned long long)world.Hash());
+    std::string json = buffer;
+
+    const GenerationPipeline& pipeline = world.getGenerationPipeline();
+    for (size_t i = 0; i < pipeline.getStats().size(); ++i) {
+        const GenerationPassStats& pass = pipeline.getStats()[i];
+        snprintf(buffer, sizeof(buffer), "%s\n       {\"name\": \"%s\", \"stage\": %d, \"cpu_ms\": %.3f, \"tiles_changed\": %llu}",
+                 i ? "," : "", pass.name, pass.stage, pass.ms, (unsigned long long)pass.tilesChanged);
+        json += buffer;
+    }
+    json += "]}";
+    return json;
+}
+
+static bool RunForked(unsigned int seed, Size size, unsigned int threads, std::string& json) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    pid_t child = fork();
+    if (child < 0) return false;
+    if (child == 0) {
+        close(fds[0]);
+        std::string result = RunOne(seed, size, threads);
+        ssize_t written = write(fds[1], result.data(), result.size());
+        _exit(written == (ssize_t)result.size() ? 0 : 1);
+    }
+
+    close(fds[1]);
+    char buffer[4096];
+    ssize_t count;
+    while ((count = read(fds[0], buffer, sizeof(buffer))) > 0) json.append(buffer, count);
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char** argv) {
+    std::vector<unsigned int> seeds = { 1, 2, 3, 2023 };
+    std::vector<Size> sizes = { { 400, 1000 }, { 800, 2000 }, { 1600, 2000 }, { 3200, 2000 } };
+    unsigned int threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--seeds=", 8) == 0) {
+            seeds.clear();
+            for (const std::string& seed : SplitList(argv[i] + 8)) seeds.push_back(strtoul(seed.c_str(), nullptr, 10));
+        } else if (strncmp(argv[i], "--sizes=", 8) == 0) {
+            sizes.clear();
+            for (const std::string& size : SplitList(argv[i] + 8)) {
+                Size parsed{};
+                if (sscanf(size.c_str(), "%dx%d", &parsed.width, &parsed.height) == 2) sizes.push_back(parsed);
+            }
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            threads = strtoul(argv[i] + 10, nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seeds=1,2] [--sizes=800x2000,1600x2000] [--threads=N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bool ok = true;
+    printf("{\n  \"runs\": [\n");
+    bool first = true;
+    for (const Size& size : sizes) {
+        for (unsigned int seed : seeds) {
+            std::string json;
+            if (!RunForked(seed, size, threads, json)) {
+                fprintf(stderr, "seed %u %dx%d failed\n", seed, size.width, size.height);
+                ok = false;
+                continue;
+            }
+            printf("%s%s", first ? "" : ",\n", json.c_str());
+            first = false;
+            fflush(stdout);
+        }
+    }
+    printf("\n  ]\n}\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+// Carves the worm caves of a few worlds with World::AddRandWorms and with the original
+// per-step disc stamping (reproduced below on a copy of each column), checks that both
+// leave identical tiles and compares their cost.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "world/world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Mirrors of the generator's private helpers, see world.cpp
+static std::mt19937 ColumnRng(unsigned int seed, int column, unsigned int pass) {
+    std::seed_seq seq{seed, static_cast<unsigned int>(column), pass};
+    return std::mt19937(seq);
+}
+
+static const unsigned int passWorms = 2;
+static const int wormReachChunks = 7;
+
+struct StampedWorms {
+    const World& world;
+    PerlinNoise perlin;
+    uint8_t* column; // World::CopyColumn layout
+
+    uint8_t& Tile(int localX, int y) {
+        return column[(y >> chunkShift) * chunkArea + (y & chunkMask) * chunkSize + (localX & chunkMask)];
+    }
+
+    int MapYToRadius(float y, int minRadius, int maxRadius) {
+        float t = y / static_cast<float>(world.getHeight());
+        return static_cast<int>(t * (maxRadius - minRadius)) + minRadius;
+    }
+
+    void AddPerlinWorm(int startX, int startY, int length, float noiseScale, int minRadius, int maxRadius, int x0, int x1) {
+        double posX = static_cast<double>(startX);
+        double posY = static_cast<double>(startY);
+
+        for (int i = 0; i < length; ++i) {
+            float angle = perlin.noise(posX * noiseScale, posY * noiseScale) * 2.0f * 3.14159f;
+
+            posX += cos(angle);
+            posY += sin(angle);
+
+            int centerX = static_cast<int>(std::floor(posX)) - world.GetOriginChunkX() * chunkSize;
+            int centerY = static_cast<int>(posY);
+
+            int radius = MapYToRadius(posY, minRadius, maxRadius);
+            if (centerX + radius < x0 || centerX - radius >= x1) continue;
+
+            for (int y = -radius; y <= radius; ++y) {
+                for (int x = -radius; x <= radius; ++x) {
+                    int nx = centerX + x;
+                    int ny = centerY + y;
+
+                    if (nx >= x0 && nx < x1 && ny >= 0 && ny < world.getHeight() && x * x + y * y <= radius * radius) {
+                        Tile(nx, ny) = World::TILE_AIR;
+                    }
+                }
+            }
+        }
+    }
+
+    void AddRandWorms(int x0, int x1) {
+        int column = world.GetOriginChunkX() + (x0 >> chunkShift);
+        int height = world.getHeight();
+
+        for (int source = column - wormReachChunks; source <= column + wormReachChunks; ++source) {
+            std::mt19937 rng = ColumnRng(world.getSeed(), source, passWorms);
+            if (rng() % 3 == 0) continue;
+
+            int startX = source * chunkSize + rng() % chunkSize;
+            int startY = 10 + rng() % (height - 20);
+
+            int length = 100 + rng() % 100;
+            float scale = 0.05f + static_cast<float>(rng()) / std::mt19937::max() * 0.1f;
+
+            int minRadius = 1;
+            int maxRadius = 4 + rng() % 3;
+
+            AddPerlinWorm(startX, startY, length, scale, minRadius, maxRadius, x0, x1);
+        }
+    }
+};
+
+int main() {
+    const unsigned int seeds[] = { 1, 2, 3, 2023 };
+    const int rounds = 5;
+    bool ok = true;
+
+    printf("%-6s %12s %12s %8s\n", "seed", "stamped ms", "spans ms", "speedup");
+    for (unsigned int seed : seeds) {
+        World world(seed);
+        world.SetGenerationThreads(1);
+        size_t columnBytes = (size_t)world.getChunksY() * chunkArea;
+
+        // Uncarved terrain for every column, as the worm pass sees it
+        std::vector<std::vector<uint8_t>> base(world.getChunksX(), std::vector<uint8_t>(columnBytes));
+        for (int cx = 0; cx < world.getChunksX(); ++cx) {
+            int x0 = cx * chunkSize;
+            int x1 = std::min(x0 + chunkSize, world.getWidth());
+            world.InitBasicGen(x0, x1);
+            world.CopyColumn(cx, base[cx].data());
+        }
+
+        double stampedMs = 0.0;
+        double spansMs = 0.0;
+        bool identical = true;
+        std::vector<uint8_t> stamped(columnBytes);
+        std::vector<uint8_t> spans(columnBytes);
+        for (int round = 0; round < rounds; ++round) {
+            world.SetSeed(seed); // drops the traced worm paths, so every round traces them again
+            for (int cx = 0; cx < world.getChunksX(); ++cx) {
+                int x0 = cx * chunkSize;
+                int x1 = std::min(x0 + chunkSize, world.getWidth());
+
+                stamped = base[cx];
+                StampedWorms reference{ world, PerlinNoise(seed), stamped.data() };
+                auto start = Clock::now();
+                reference.AddRandWorms(x0, x1);
+                stampedMs += msSince(start);
+
+                start = Clock::now();
+                world.AddRandWorms(x0, x1);
+                spansMs += msSince(start);
+
+                // Worms only ever carve air, so carving a column again changes nothing
+                world.CopyColumn(cx, spans.data());
+                identical = identical && memcmp(stamped.data(), spans.data(), columnBytes) == 0;
+            }
+        }
+        ok = ok && identical;
+
+        printf("%-6u %12.2f %12.2f %7.2fx %s\n", seed, stampedMs / rounds, spansMs / rounds,
+               stampedMs / spansMs, identical ? "identical" : "DIFFERS");
+    }
+    return ok ? 0 : 1;
+}
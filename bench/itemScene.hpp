@@ -0,0 +1,35 @@
+#pragma once
+// The item side of a game tick over a generated world, without a window, for the item
+// benches: a player and inventory to pick up into, the physics the items move in, and the
+// block editor to mine with. The player starts far from every item.
+#include "game/itemManager.hpp"
+#include "physics/physicsSystem.hpp"
+#include "player/blockEditor.hpp"
+#include "player/camera.hpp"
+#include "player/inventory.hpp"
+
+struct ItemScene {
+    World& world;
+    Player player;
+    Inventory inventory;
+    PhysicsSystem physics;
+    ItemManager itemManager{ physics };
+    GameCamera camera;
+    BlockEditor editor{ world, camera };
+    int camX, camY; // the screen items are simulated around
+
+    ItemScene(World& world, int camX = 0, int camY = 0) : world(world), camX(camX), camY(camY) {
+        player.x = camX - 4000.0f;
+        player.y = camY;
+    }
+
+    ~ItemScene() { itemManager.Clear(); }
+
+    void Tick() { Tick(camX, camY); }
+
+    void Tick(int atCamX, int atCamY) {
+        itemManager.BeginTick(world, player, atCamX, atCamY);
+        physics.Step(1.0f / 60.0f, world);
+        itemManager.EndTick(1.0f / 60.0f, player, inventory);
+    }
+};
@@ -0,0 +1,49 @@
+// Generates one world headless and prints how long each generation pass took and how
+// many tiles it changed. Usage: worldgen_passes [seed] [threads]
+#include <cstdio>
+#include <cstdlib>
+#include "world/world.hpp"
+
+static void PrintTileMask(uint32_t mask) {
+    static const char* names[World::TILE_COUNT] = { "air", "stone", "dirt", "grass", "trunk", "leaves" };
+    if (mask == (1u << World::TILE_COUNT) - 1) {
+        printf("%-24s", "any");
+        return;
+    }
+
+    char text[64] = "";
+    int length = 0;
+    for (int tile = 0; tile < World::TILE_COUNT; ++tile) {
+        if (mask & (1u << tile)) {
+            length += snprintf(text + length, sizeof(text) - length, "%s%s", length ? "," : "", names[tile]);
+        }
+    }
+    printf("%-24s", text);
+}
+
+int main(int argc, char** argv) {
+    unsigned int seed = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2023;
+    unsigned int threads = argc > 2 ? strtoul(argv[2], nullptr, 10) : 0;
+
+    World world(seed);
+    world.SetGenerationThreads(threads);
+    world.GenerateTerrain();
+
+    const GenerationPipeline& pipeline = world.getGenerationPipeline();
+    double totalMs = 0.0;
+    for (const GenerationPassStats& pass : pipeline.getStats()) totalMs += pass.ms;
+
+    printf("\nseed %u, %d x %d tiles, %d stages\n\n", seed, world.getWidth(), world.getHeight(),
+           pipeline.getStageCount());
+    printf("%-16s %5s  %-24s%-24s %10s %6s %12s\n", "pass", "stage", "reads", "writes", "cpu ms", "share", "tiles");
+    for (size_t i = 0; i < pipeline.getStats().size(); ++i) {
+        const GenerationPassStats& pass = pipeline.getStats()[i];
+        printf("%-16s %5d  ", pass.name, pass.stage);
+        PrintTileMask(pipeline.getPasses()[i].reads);
+        PrintTileMask(pipeline.getPasses()[i].writes);
+        printf(" %10.2f %5.1f%% %12llu\n", pass.ms, totalMs > 0.0 ? 100.0 * pass.ms / totalMs : 0.0,
+               (unsigned long long)pass.tilesChanged);
+    }
+    printf("%-16s %5s  %-48s %10.2f  (wall %.2f ms)\n", "total", "", "", totalMs, pipeline.getWallMs());
+    return 0;
+}
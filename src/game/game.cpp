@@ -1,19 +1,31 @@
 #include "game.hpp"
+#include <algorithm>
 #include <iostream>
+#include "../util/utils.hpp"
+#include "../render/drawBackend.hpp"
 
 Game::Game()
-    : editor(world, camera) // initialize editor
+    : world(generateRandomSeed()),
+      editor(world, camera), // initialize editor
+      itemManager(physics),
+      startupStart(std::chrono::steady_clock::now())
 {
     std::cout << "Game Constructor Started...." << std::endl;
 
     textrueManager.Load();
     std::cout << "Texture Manager Loaded." << std::endl;
 
-    world.GenerateTerrain();
-    std::cout << "Terrain Generated." << std::endl;
-
-    player.Init(world);
-    std::cout << "Initialized The Player." << std::endl;
+    if (streamWorld) {
+        world.EnableStreaming("saves/columns");
+    }
+    if (saveManager.Load(world, player, inventory)) {
+        std::cout << "Save Loaded." << std::endl;
+    } else {
+        world.ClearStreamCache();
+        world.StartGenerating((world.getWidth() / 2) >> chunkShift); // where FindSpawn looks
+        loading = true;
+        std::cout << "Generating terrain from seed " << world.getSeed() << "..." << std::endl;
+    }
 
     worldPixelWidth = world.getWidth() * tileSize;
     worldPixelHeight = world.getHeight() * tileSize;
@@ -21,37 +33,146 @@ Game::Game()
     std::cout << "Game Constructor Completed." << std::endl;
 }
 
-void Game::Update(float deltaTime) {
-    player.Update(deltaTime, world);
-    editor.Update(player, itemManager);
-    itemManager.Update(deltaTime, world, player, camera.x, camera.y, inventory);
+int Game::Update(float frameTime) {
+    if (!world.IsGenerating()) {
+        world.FinishGenerating(); // joins the worker once it is done
+    }
+
+    if (loading) {
+        if (!m_SpawnRegionReady()) return 0;
+
+        player.Init(world);
+        loading = false;
+        std::cout << "Spawn region ready after " << m_MsSinceStartup() << " ms." << std::endl;
+    }
+
+    if (IsKeyPressed(KEY_F5) && !world.IsGenerating()) {
+        saveManager.Save(world, player, inventory);
+    }
+
+    // Input and UI follow frames, everything that moves follows ticks
+    player.PollInput();
+    editor.PollInput();
     inventory.Update(player);
 
+    tickAccumulator = std::min(tickAccumulator + frameTime, maxTicksPerFrame * tickSeconds);
+    int ticks = 0;
+    while (tickAccumulator >= tickSeconds) {
+        m_Tick();
+        tickAccumulator -= tickSeconds;
+        ++ticks;
+    }
+    interpolation = tickAccumulator / tickSeconds;
+    camera.Interpolate(interpolation);
+    return ticks;
+}
+
+void Game::m_Tick() {
+    int tileShift = world.UpdateStreaming((int)floorf(player.x / tileSize));
+    if (tileShift != 0) {
+        m_ShiftOrigin(tileShift);
+    }
+
+    // Player and items set up their bodies, one step moves them all, then each reads back
+    player.Update(tickSeconds, world, physics);
+    itemManager.BeginTick(world, player, camera.x, camera.y);
+    physics.Step(tickSeconds, world);
+    player.EndTick(physics);
+    itemManager.EndTick(tickSeconds, player, inventory);
+
+    world.UpdateCompression((int)floorf(player.x / tileSize), (int)floorf(player.y / tileSize));
+    editor.Update(player, itemManager);
+
     camera.Follow(
         floorf(player.x),
         floorf(player.y),
-        deltaTime,
-        GetScreenWidth(),
-        GetScreenHeight(),
+        tickSeconds,
+        GetDrawBackend().GetScreenWidth(),
+        GetDrawBackend().GetScreenHeight(),
         worldPixelWidth,
         worldPixelHeight
     );
 }
 
 void Game::Draw() {
-    int camDrawX = (int)floor(camera.x);
-    int camDrawY = (int)floor(camera.y);
+    DrawBackend& backend = GetDrawBackend();
+    if (loading) {
+        m_DrawLoadingScreen();
+        return;
+    }
+
+    int camDrawX = camera.drawX;
+    int camDrawY = camera.drawY;
 
-    world.Render(camDrawX, camDrawY, GetScreenWidth(), GetScreenHeight(), textrueManager);
-    player.Draw(camDrawX, camDrawY);
-    itemManager.Render(camDrawX, camDrawY, textrueManager);
+    world.Render(camDrawX, camDrawY, backend.GetScreenWidth(), backend.GetScreenHeight(), textrueManager);
+    player.Draw(camDrawX, camDrawY, interpolation);
+    itemManager.Render(camDrawX, camDrawY, textrueManager, interpolation);
     editor.DrawHighlight(player);
 
     // UI
     player.DrawUI();
     inventory.Draw();
+
+    if (!firstFrameLogged) {
+        firstFrameLogged = true;
+        std::cout << "First interactive frame after " << m_MsSinceStartup() << " ms." << std::endl;
+    }
+}
+
+bool Game::IsLoading() const { return loading; }
+const Player& Game::getPlayer() const { return player; }
+ItemManager& Game::getItemManager() { return itemManager; }
+
+double Game::m_MsSinceStartup() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupStart).count();
+}
+
+bool Game::m_SpawnRegionReady() const {
+    int spawnChunkX = (world.getWidth() / 2) >> chunkShift;
+    for (int cx = spawnChunkX - spawnRegionChunks; cx <= spawnChunkX + spawnRegionChunks; ++cx) {
+        if (cx >= 0 && cx < world.getChunksX() && !world.IsColumnReady(cx)) return false;
+    }
+    return true;
+}
+
+void Game::m_DrawLoadingScreen() {
+    DrawBackend& backend = GetDrawBackend();
+    World::GenerationStatus status = world.GetGenerationStatus();
+    int screenWidth = backend.GetScreenWidth();
+    int screenHeight = backend.GetScreenHeight();
+
+    backend.DrawRectangle(0, 0, screenWidth, screenHeight, BLACK);
+
+    const char* title = "Generating world...";
+    backend.DrawText(title, (screenWidth - backend.MeasureText(title, 30)) / 2, screenHeight / 2 - 60, 30, RAYWHITE);
+
+    int barWidth = screenWidth / 2;
+    int barX = (screenWidth - barWidth) / 2;
+    int barY = screenHeight / 2;
+    backend.DrawRectangle(barX, barY, (int)(barWidth * status.progress), 20, GREEN);
+    backend.DrawRectangleLines(barX, barY, barWidth, 20, RAYWHITE);
+
+    const char* detail = TextFormat("%s  %d%%  (%d / %d columns)", status.pass ? status.pass : "starting",
+                                    (int)(status.progress * 100.0f), status.readyColumns, world.getChunksX());
+    backend.DrawText(detail, (screenWidth - backend.MeasureText(detail, 20)) / 2, barY + 40, 20, LIGHTGRAY);
+}
+
+// The streamed world moved its window, so everything in window-local pixels follows
+void Game::m_ShiftOrigin(int tileShift) {
+    float dx = (float)(tileShift * tileSize);
+    player.x -= dx;
+    player.prevX -= dx;
+    player.spawnX -= dx;
+    camera.x -= dx;
+    camera.prevX -= dx;
+    camera.Interpolate(interpolation);
+    physics.Shift(dx);
+    itemManager.ShiftItems(dx);
 }
 
 void Game::Destroy() {
+    world.FinishGenerating();
+    saveManager.Save(world, player, inventory);
+    world.getRenderCache().Unload();
     textrueManager.Unload();
 }
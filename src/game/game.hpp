@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../physics/physicsSystem.hpp"
 #include "../player/player.hpp"
 #include "../player/inventory.hpp"
 #include "../world/world.hpp"
@@ -8,24 +9,51 @@
 #include "../player/blockEditor.hpp"
 #include "../player/camera.hpp"
 #include "itemManager.hpp"
+#include "saveManager.hpp"
+#include <chrono>
 
 class Game {
 public:
     Game();
-    void Update(float deltaTime);
+    // The simulation advances in fixed ticks whatever the frame rate, and Draw shows the
+    // world interpolated between the last two. Returns the ticks this frame ran.
+    int Update(float frameTime);
     void Draw();
     void Destroy();
+    bool IsLoading() const; // the spawn region is still generating
+    const Player& getPlayer() const;
+    ItemManager& getItemManager();
 
 private:
     World world;
+    PhysicsSystem physics;
     Player player;
     Inventory inventory;
     GameCamera camera;
     BlockEditor editor;
     ItemManager itemManager;
     TextureManager textrueManager;
+    SaveManager saveManager;
 
     int worldPixelWidth;
     int worldPixelHeight;
+
+    static constexpr float tickSeconds = 1.0f / 60.0f;
+    static constexpr int maxTicksPerFrame = 8; // a longer stall drops time rather than snowballing
+    float tickAccumulator = 0.0f;
+    float interpolation = 0.0f; // 0 at the previous tick, 1 at the latest
+
+    // Startup: a fresh world generates in the background and play begins once the
+    // columns around spawn are ready
+    static constexpr int spawnRegionChunks = 3; // chunk columns either side of spawn
+    bool loading = false;
+    bool firstFrameLogged = false;
+    std::chrono::steady_clock::time_point startupStart;
+
+    void m_Tick();
+    void m_ShiftOrigin(int tileShift);
+    bool m_SpawnRegionReady() const;
+    void m_DrawLoadingScreen();
+    double m_MsSinceStartup() const;
 };
 
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <raylib.h>
 #include "../world/world.hpp"
+#include "../physics/physicsSystem.hpp"
 #include "../player/player.hpp"
 
 // item class for definition of items
@@ -11,16 +12,19 @@ public:
     char name[64];
     float xPos = 0.0f; // world coords if dropped on the ground
     float yPos = 0.0f;
-    float speed = 300.0f;
-    float friction = 350.0f; // friction
+    float prevX = 0.0f; // position before the latest tick, for drawing between ticks
+    float prevY = 0.0f;
     float vx = 0;
     float vy = 0;
-    float gravity = 1200.0f;
-    float maxFallSpeed = 10000.0f;
+    // While dropped the body moves the item; the fields above copy it after each step
+    PhysicsSystem::BodyId body = PhysicsSystem::noBody;
     float phaseOffset = GetRandomValue(550, 628) / 150.0f;
+    static constexpr float hoverAmplitude = 1.5f; // pixels
+    static constexpr float hoverSpeed = 2.5f;     // radians per second
     float size = 15.0f;
     double distanceToPlayer = 0;
-    int itemWeight = 0;
+    int itemWeight = 0; // of one
+    int count = 1;      // identical items resting together on the ground share one Item
     uint64_t id;
 
     char chestID[64]; // if stored in a chest what chest its stored in
@@ -51,17 +55,6 @@ public:
 
     ItemRenderType texture;
                            
-    bool IsCollidingAt(float px, float py, float w, float h, const World& world) const;
-    bool IsColliding(const World& world) const;
-    void MoveX(float dx, const World& world);
-    void MoveY(float dy, const World& world);
     void SetIgnorePickupTimer(float time);
     void IgnorePickup(float deltaTime);
-    
-    void UpdateDropped(float deltaTime, World& world, Player& player);
-    void RenderDropped(float x, float y, TextureManager& textureManager);
-private:
-    void MoveDroppedTowardPlayer(float deltaTime, Player& player);
-    void ApplyFriction(float deltaTime);
-    float m_HoverAnimation();
 };
@@ -1,8 +1,11 @@
 #include "itemManager.hpp"
 #include "item.hpp"
 #include "../player/inventory.hpp"
+#include "../render/drawBackend.hpp"
+#include "../util/utils.hpp"
 #include <algorithm>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <ostream>
@@ -13,61 +16,223 @@
 static std::unordered_set<uint64_t> usedIds;
 std::vector<Item> ItemManager::items;
 
+ItemManager::ItemManager(PhysicsSystem& physics) : physics(physics) {}
+
 void ItemManager::CreateDroppedItem(const char* name, float x, float y, int itemWeight, Item::ItemRenderType texture) {
     Item item;
     std::strncpy(item.name, name, sizeof(item.name));
     item.name[sizeof(item.name) - 1] = '\0';
     item.xPos = x + (tileSize / 2) - (item.size / 2);
     item.yPos = y;
+    item.prevX = item.xPos;
+    item.prevY = item.yPos;
     item.itemWeight = itemWeight;
     item.location = Item::DROPPED;
     item.texture = texture;
-    item.id = m_GenerateUniqueId();
+    item.id = GenerateUniqueId();
+    item.body = physics.Add(item.xPos, item.yPos, item.size, item.size, PhysicsSystem::MATERIAL_ITEM);
+    physics.owner[physics.IndexOf(item.body)] = (uint32_t)items.size();
     std::cout << item.id << std::endl;
 
     items.push_back(item);
 }
 
-void ItemManager::Update(float deltaTime, World& world, Player& player, int camX, int camY, Inventory& inventory) {
-    std::vector<uint64_t> itemsToRemove;
+// Items are simulated by distance from the screen: full rate on it, coarse ticks within
+// simulationRadius of it, and beyond that they are suspended until the screen comes
+// back near them. Sleepers cost nothing here until the player comes within reach.
+void ItemManager::BeginTick(const World& world, const Player& player, int camX, int camY) {
+    int screenWidth = GetDrawBackend().GetScreenWidth();
+    int screenHeight = GetDrawBackend().GetScreenHeight();
 
-    for (auto& item : items) {
-        if (item.xPos < camX + GetScreenWidth() && item.xPos > camX && item.yPos > camY && item.yPos < camY + GetScreenHeight()) {
-            if (item.location == Item::DROPPED) {
-                item.UpdateDropped(deltaTime, world, player);
-                if (PickupItem(item, player, inventory)) {
-                    itemsToRemove.push_back(item.id);
-                }
-            }
+    // Items that arrived since the last tick, by AddItemToWorld, get their bodies
+    for (size_t slot = std::min(firstNewItem, items.size()); slot < items.size(); ++slot) {
+        Item& item = items[slot];
+        if (item.body == PhysicsSystem::noBody) {
+            item.body = physics.Add(item.xPos, item.yPos, item.size, item.size, PhysicsSystem::MATERIAL_ITEM);
+            int index = physics.IndexOf(item.body);
+            physics.vx[index] = item.vx;
+            physics.vy[index] = item.vy;
         }
+        physics.owner[physics.IndexOf(item.body)] = (uint32_t)slot;
     }
+    firstNewItem = items.size();
+
+    float farX0 = camX - simulationRadius;
+    float farY0 = camY - simulationRadius;
+    float farX1 = camX + screenWidth + simulationRadius;
+    float farY1 = camY + screenHeight + simulationRadius;
+    physics.ResumeOverlapping(farX0, farY0, farX1, farY1, world);
+    physics.WakeWithin(player.x + (tileSize / 2), player.y + tileSize, player.itemPickupDistance);
 
-    for (auto id : itemsToRemove) {
-        m_RemoveItemFromWorld(id);
+    std::vector<PhysicsSystem::BodyId> outOfRange;
+    for (int index = 0; index < physics.getAwakeCount(); ++index) {
+        if (physics.material[index] != PhysicsSystem::MATERIAL_ITEM) continue;
+        uint8_t& flags = physics.flags[index];
+        flags &= ~(PhysicsSystem::BODY_ACTIVE | PhysicsSystem::BODY_COARSE);
+        if (items[physics.owner[index]].location != Item::DROPPED) continue;
+
+        float x = physics.x[index];
+        float y = physics.y[index];
+        if (x < camX + screenWidth && x > camX && y > camY && y < camY + screenHeight) {
+            flags |= PhysicsSystem::BODY_ACTIVE;
+        } else if (x < farX1 && x + physics.width[index] > farX0 && y < farY1 && y + physics.height[index] > farY0) {
+            flags |= PhysicsSystem::BODY_ACTIVE | PhysicsSystem::BODY_COARSE;
+        } else {
+            outOfRange.push_back(items[physics.owner[index]].body);
+        }
+    }
+    for (auto body : outOfRange) {
+        physics.Suspend(body);
     }
 }
 
-void ItemManager::Render(float camX, float camY, TextureManager& textureManager) { // camerax and y
-    for (auto& item : items) {
-        if (item.xPos < camX + GetScreenWidth() && item.xPos > camX && item.yPos > camY && item.yPos < camY + GetScreenHeight()) {
-            if (item.location == Item::DROPPED) {
-                item.RenderDropped(camX, camY, textureManager);
+void ItemManager::EndTick(float deltaTime, Player& player, Inventory& inventory) {
+    const float moveSpeed = 0.2f; // share of the gap to the player added to the velocity each tick
+    std::vector<PhysicsSystem::BodyId> pickedUp, resting;
+
+    for (int index = 0; index < physics.getAwakeCount(); ++index) {
+        uint8_t flags = physics.flags[index];
+        if (physics.material[index] != PhysicsSystem::MATERIAL_ITEM || !(flags & PhysicsSystem::BODY_ACTIVE)) continue;
+
+        Item& item = items[physics.owner[index]];
+        item.prevX = physics.prevX[index];
+        item.prevY = physics.prevY[index];
+        item.xPos = physics.x[index];
+        item.yPos = physics.y[index];
+
+        item.distanceToPlayer = findDistance(player.x + (tileSize / 2), player.y + tileSize, item.xPos, item.yPos);
+        if (!player.inventoryFull && item.distanceToPlayer <= player.itemPickupDistance && !item.ignorePickup) {
+            Vector2 diff = diffVector(player.x, player.y, item.xPos, item.yPos);
+            physics.vx[index] -= diff.x * moveSpeed;
+            physics.vy[index] -= diff.y * moveSpeed;
+        }
+        item.vx = physics.vx[index];
+        item.vy = physics.vy[index];
+
+        item.IgnorePickup(deltaTime);
+        if (PickupItem(item, player, inventory)) {
+            pickedUp.push_back(item.body);
+            continue;
+        }
+
+        // On the ground, still and out of the player's reach: nothing moves it again until
+        // a tile next to it changes or the player comes close
+        bool atRest = (flags & PhysicsSystem::BODY_HIT_Y) && item.xPos == item.prevX && item.yPos == item.prevY &&
+                      item.vx == 0.0f && item.vy == 0.0f;
+        if (sleeping && atRest && item.distanceToPlayer > player.itemPickupDistance && !item.ignorePickup) {
+            resting.push_back(item.body);
+        }
+    }
+
+    for (auto body : resting) {
+        if (stacking && m_MergeIntoStack(body)) continue;
+        physics.Sleep(body);
+    }
+    for (auto body : pickedUp) {
+        m_RemoveItemFromWorld(body);
+    }
+}
+
+void ItemManager::WakeItemsNear(int tileX, int tileY) {
+    physics.WakeOverlapping((tileX - 1) * tileSize, (tileY - 1) * tileSize, (tileX + 2) * tileSize, (tileY + 2) * tileSize);
+}
+
+void ItemManager::SetSleeping(bool enabled) { sleeping = enabled; }
+void ItemManager::SetStacking(bool enabled) { stacking = enabled; }
+void ItemManager::SetSimulationRadius(float pixels) { simulationRadius = pixels; }
+
+// Every dropped item on screen in one pass: hover offsets for all of them from a single time
+// sample, then all the shadows, then all the sprites, written straight into one atlas batch.
+// Items are drawn between their positions before and after the latest step.
+void ItemManager::Render(float camX, float camY, TextureManager& textureManager, float interpolation) { // camerax and y
+    int screenWidth = GetDrawBackend().GetScreenWidth();
+    int screenHeight = GetDrawBackend().GetScreenHeight();
+
+    // Compact copies of what drawing needs, so the passes below never touch an Item again
+    visibleItems.resize(items.size());
+    hoverOffsets.resize(items.size() + hoverBlock);
+    int count = 0;
+    for (const auto& item : items) {
+        if (item.xPos < camX + screenWidth && item.xPos > camX && item.yPos > camY && item.yPos < camY + screenHeight) {
+            int slot = TextureManager::GetItemSlot(item.texture);
+            if (item.location == Item::DROPPED && slot >= 0) {
+                float x = item.prevX + (item.xPos - item.prevX) * interpolation;
+                float y = item.prevY + (item.yPos - item.prevY) * interpolation;
+                visibleItems[count] = {(int)x, (int)y, (int)item.size, slot, item.count};
+                hoverOffsets[count] = item.phaseOffset;
+                ++count;
             }
         }
     }
+    if (count == 0) return;
+
+    // Whole blocks keep this loop vectorized at -O2; the padding after count is scratch
+    float phase = (float)GetTime() * Item::hoverSpeed;
+    float* hover = hoverOffsets.data();
+    std::fill(hover + count, hover + hoverOffsets.size(), 0.0f);
+    for (int i = 0; i < count; i += hoverBlock) {
+        for (int j = 0; j < hoverBlock; ++j) {
+            hover[i + j] = fastSin(phase + hover[i + j]) * Item::hoverAmplitude;
+        }
+    }
+
+    Rectangle sources[TextureManager::TEXTURE_COUNT];
+    for (int slot = 0; slot < TextureManager::TEXTURE_COUNT; ++slot) sources[slot] = textureManager.GetSpriteSource(slot);
+    Rectangle rectSource = textureManager.GetRectSource();
+
+    textureManager.BeginBatch();
+    TexturedQuad* shadows = textureManager.AppendToBatch(2 * count);
+    TexturedQuad* sprites = shadows + count;
+    for (int i = 0; i < count; ++i) {
+        const VisibleItem& item = visibleItems[i];
+        Rectangle shadow, sprite;
+        TextureManager::GetDroppedItemRects(item.x, item.y, camX, camY, item.size, hover[i], shadow, sprite);
+        shadows[i] = {rectSource, shadow, BLACK};
+        sprites[i] = {sources[item.slot], sprite, WHITE};
+    }
+    textureManager.FlushBatch();
+
+    // Stack sizes over the sprites; few items on screen are stacks, so these stay out of the batch
+    DrawBackend& backend = GetDrawBackend();
+    char countText[16];
+    for (int i = 0; i < count; ++i) {
+        const VisibleItem& item = visibleItems[i];
+        if (item.count < 2) continue;
+        snprintf(countText, sizeof(countText), "%d", item.count);
+        backend.DrawText(countText, item.x - (int)camX + item.size - 4, item.y - (int)camY + (int)hover[i] + item.size - 6,
+                         10, WHITE);
+    }
+}
+
+void ItemManager::ShiftItems(float dx) {
+    for (auto& item : items) {
+        item.xPos -= dx;
+        item.prevX -= dx;
+    }
 }
 
 bool ItemManager::PickupItem(Item& item, Player& player, Inventory& inventory) {
     player.inventoryFull = inventory.IsInventoryFull();
-    if (item.distanceToPlayer <= player.itemGrabDistance && !inventory.IsInventoryFull() && !item.ignorePickup) {
-        item.location = Item::INVENTORY;
-        inventory.AddItemToInventory(item);
-        return true;
+    if (item.distanceToPlayer > player.itemGrabDistance || player.inventoryFull || item.ignorePickup) return false;
+
+    int room = inventory.RoomFor(item);
+    if (room <= 0) return false;
+    if (room < item.count) { // takes what fits, the rest of the stack stays where it lies
+        Item taken = item;
+        taken.id = GenerateUniqueId();
+        taken.count = room;
+        taken.location = Item::INVENTORY;
+        inventory.AddItemToInventory(taken);
+        item.count -= room;
+        player.inventoryFull = inventory.IsInventoryFull();
+        return false;
     }
-    return false;
+    item.location = Item::INVENTORY;
+    inventory.AddItemToInventory(item);
+    return true;
 }
 
-uint64_t ItemManager::m_GenerateUniqueId() {
+uint64_t ItemManager::GenerateUniqueId() {
     static std::mt19937_64 rng(std::random_device{}());
     static std::uniform_int_distribution<uint64_t> dist;
 
@@ -80,20 +245,67 @@ uint64_t ItemManager::m_GenerateUniqueId() {
     return id;
 }
 
+void ItemManager::ReserveId(uint64_t id) {
+    usedIds.insert(id);
+}
+
 void ItemManager::m_RemoveId(uint64_t id) {
     usedIds.erase(id);
 }
 
 void ItemManager:: AddItemToWorld(Item&& item) {
+    item.body = PhysicsSystem::noBody; // any it had was left behind with its last stay in the world
+    item.prevX = item.xPos;
+    item.prevY = item.yPos;
     items.push_back(std::move(item));
 }
 
-void ItemManager::m_RemoveItemFromWorld(uint64_t id) {
-    items.erase(
-            std::remove_if(items.begin(), items.end(),
-                [id](const Item& item) {
-                    return item.id == id;
-                }),
-                items.end()
-            );
+void ItemManager::Clear() {
+    for (const Item& item : items) physics.Remove(item.body);
+    items.clear();
+    firstNewItem = 0;
+}
+
+// An item coming to rest joins a sleeping stack of the same thing within a tile of it, so
+// a mined-out pile is a handful of Items and bodies instead of one per block. Returns
+// whether it did; the item and its body are gone then.
+bool ItemManager::m_MergeIntoStack(PhysicsSystem::BodyId body) {
+    int index = physics.IndexOf(body);
+    const Item& item = items[physics.owner[index]];
+    float x0 = physics.x[index] - tileSize;
+    float y0 = physics.y[index] - tileSize;
+    float x1 = physics.x[index] + physics.width[index] + tileSize;
+    float y1 = physics.y[index] + physics.height[index] + tileSize;
+
+    for (PhysicsSystem::BodyId otherBody : physics.SleepingOverlapping(x0, y0, x1, y1)) {
+        int other = physics.IndexOf(otherBody);
+        if (physics.material[other] != PhysicsSystem::MATERIAL_ITEM) continue;
+        Item& stack = items[physics.owner[other]];
+        if (stack.location != Item::DROPPED || stack.texture != item.texture || stack.count + item.count > maxStackCount ||
+            std::strcmp(stack.name, item.name) != 0) {
+            continue;
+        }
+        stack.count += item.count;
+        m_RemoveId(item.id);
+        m_RemoveItemFromWorld(body);
+        return true;
+    }
+    return false;
+}
+
+// The last item fills the hole, and its body learns where it went
+void ItemManager::m_RemoveItemFromWorld(PhysicsSystem::BodyId body) {
+    size_t slot = physics.owner[physics.IndexOf(body)];
+    physics.Remove(body);
+
+    if (slot != items.size() - 1) {
+        items[slot] = std::move(items.back());
+        int moved = physics.IndexOf(items[slot].body);
+        if (moved >= 0) {
+            physics.owner[moved] = (uint32_t)slot;
+        } else {
+            firstNewItem = std::min(firstNewItem, slot);
+        }
+    }
+    items.pop_back();
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "item.hpp"
+#include "../physics/physicsSystem.hpp"
 #include "../world/world.hpp"
 #include <cstdint>
 #include <raylib.h>
@@ -13,15 +14,44 @@ class Inventory;
 
 class ItemManager {
 public:
+    explicit ItemManager(PhysicsSystem& physics);
+
     static std::vector<Item> items;
 
     void CreateDroppedItem(const char* name, float x, float y, int itemWeight, Item::ItemRenderType textrue);
-    static void AddItemToWorld(Item&& item);
-    void Update(float deltaTime, World& world, Player& player, int camX, int camY, Inventory& inventory);
-    void Render(float camX, float camY, TextureManager& textureManager);
+    static void AddItemToWorld(Item&& item); // it gets a body on the next tick
+    static void ReserveId(uint64_t id); // keeps ids restored from a save unique
+    static uint64_t GenerateUniqueId();
+    // The items' share of a tick, either side of PhysicsSystem::Step: BeginTick picks the
+    // bodies to step, EndTick copies them back, pulls items toward the player, picks up
+    // and puts the ones at rest to sleep, or onto an identical stack resting next to them
+    void BeginTick(const World& world, const Player& player, int camX, int camY);
+    void EndTick(float deltaTime, Player& player, Inventory& inventory);
+    void WakeItemsNear(int tileX, int tileY); // the tile changed, so items around it may fall
+    void SetSleeping(bool enabled);           // on by default
+    void SetStacking(bool enabled);           // on by default; stacks only form as items fall asleep
+    void SetSimulationRadius(float pixels);   // how far past the screen items keep coarse ticks
+    void Render(float camX, float camY, TextureManager& textureManager, float interpolation = 1.0f);
+    void ShiftItems(float dx);
+    void Clear(); // removes every item and its body
 private:
+    PhysicsSystem& physics;
+    size_t firstNewItem = 0; // items from here on may still need a body
+    bool sleeping = true;
+    bool stacking = true;
+    static constexpr int maxStackCount = 64;
+    float simulationRadius = 1280.0f;
+
     bool PickupItem(Item& item, Player& player, Inventory& inventory);
-    uint64_t m_GenerateUniqueId();
     void m_RemoveId(uint64_t id);
-    void m_RemoveItemFromWorld(uint64_t id);
+    void m_RemoveItemFromWorld(PhysicsSystem::BodyId body);
+    bool m_MergeIntoStack(PhysicsSystem::BodyId body);
+
+    // Render scratch, kept to avoid allocating every frame
+    struct VisibleItem {
+        int x, y, size, slot, count;
+    };
+    std::vector<VisibleItem> visibleItems;
+    std::vector<float> hoverOffsets; // phase in, pixels out
+    static constexpr int hoverBlock = 8;
 };
@@ -0,0 +1,294 @@
+#include "saveManager.hpp"
+#include "itemManager.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "../util/mappedFile.hpp"
+
+namespace {
+
+constexpr char saveMagic[8] = {'M', 'I', 'N', 'E', 'S', 'A', 'V', 'E'};
+constexpr uint32_t saveVersion = 3; // 2: items carry a stack count, 3: surface, occupancy and light saved
+constexpr uint64_t tileAlignment = 4096; // page aligned so the tile block maps cleanly
+
+struct SaveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t seed;
+    int32_t width;
+    int32_t height;
+    int32_t chunkSize;
+    int32_t chunksX;
+    int32_t chunksY;
+    int32_t originChunkX;
+    uint32_t itemCount;
+    uint32_t inventoryCount;
+    uint32_t lightBlocks;
+    uint32_t pad;
+    uint64_t playerOffset;
+    uint64_t itemsOffset;
+    uint64_t inventoryOffset;
+    uint64_t flagsOffset;
+    uint64_t indexOffset;
+    uint64_t lightOffset;
+    uint64_t tilesOffset;
+    uint64_t fileSize;
+};
+
+struct PlayerRecord {
+    float x, y;
+    float vx, vy;
+    float spawnX, spawnY;
+    int32_t health;
+    uint8_t isDead;
+    uint8_t faceDir;
+    uint8_t pad[2];
+};
+
+struct ItemRecord {
+    char name[64];
+    float x, y;
+    float vx, vy;
+    int32_t itemWeight;
+    int32_t texture;
+    int32_t count;
+    uint8_t pad[4];
+    uint64_t id;
+};
+
+ItemRecord ToRecord(const Item& item) {
+    ItemRecord record{};
+    std::memcpy(record.name, item.name, sizeof(record.name));
+    record.x = item.xPos;
+    record.y = item.yPos;
+    record.vx = item.vx;
+    record.vy = item.vy;
+    record.itemWeight = item.itemWeight;
+    record.texture = item.texture;
+    record.count = item.count;
+    record.id = item.id;
+    return record;
+}
+
+Item FromRecord(const ItemRecord& record, Item::ItemLocation location) {
+    Item item;
+    std::memcpy(item.name, record.name, sizeof(item.name));
+    item.name[sizeof(item.name) - 1] = '\0';
+    item.xPos = record.x;
+    item.yPos = record.y;
+    item.vx = record.vx;
+    item.vy = record.vy;
+    item.itemWeight = record.itemWeight;
+    item.texture = static_cast<Item::ItemRenderType>(record.texture);
+    item.count = std::max(record.count, 1);
+    item.id = record.id;
+    item.location = location;
+    return item;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Whether count records of recordSize bytes from offset fit in the file, without overflowing
+bool FitsInFile(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize) {
+    return offset <= fileSize && count <= (fileSize - offset) / recordSize;
+}
+
+// Whether every byte is below limit, as one max over the run so it vectorises
+bool AllBelow(const uint8_t* bytes, uint64_t count, uint8_t limit) {
+    uint8_t highest = 0;
+    for (uint64_t i = 0; i < count; ++i) highest = std::max(highest, bytes[i]);
+    return highest < limit;
+}
+
+}
+
+SaveManager::SaveManager(std::string path) : path(std::move(path)) {}
+
+bool SaveManager::Exists() const {
+    return std::filesystem::exists(path);
+}
+
+bool SaveManager::Save(const World& world, const Player& player, const Inventory& inventory) const {
+    std::vector<ItemRecord> dropped;
+    for (const Item& item : ItemManager::items) {
+        if (item.location == Item::DROPPED) dropped.push_back(ToRecord(item));
+    }
+    std::vector<ItemRecord> carried;
+    for (const Item& item : inventory.inventory) {
+        carried.push_back(ToRecord(item));
+    }
+
+    int chunkCount = world.getChunksX() * world.getChunksY();
+
+    SaveHeader header{};
+    std::memcpy(header.magic, saveMagic, sizeof(saveMagic));
+    header.version = saveVersion;
+    header.seed = world.getSeed();
+    header.width = world.getWidth();
+    header.height = world.getHeight();
+    header.chunkSize = chunkSize;
+    header.chunksX = world.getChunksX();
+    header.chunksY = world.getChunksY();
+    header.originChunkX = world.GetOriginChunkX();
+    header.itemCount = dropped.size();
+    header.inventoryCount = carried.size();
+    header.playerOffset = sizeof(SaveHeader);
+    header.itemsOffset = header.playerOffset + sizeof(PlayerRecord);
+    header.inventoryOffset = header.itemsOffset + dropped.size() * sizeof(ItemRecord);
+    header.flagsOffset = header.inventoryOffset + carried.size() * sizeof(ItemRecord);
+    header.indexOffset = AlignUp(header.flagsOffset + chunkCount, sizeof(uint64_t));
+    header.lightOffset = header.indexOffset + world.getSavedIndexBytes();
+    header.lightBlocks = world.getSavedLightBlocks();
+    uint64_t lightEnd = header.lightOffset + (uint64_t)chunkCount * sizeof(uint32_t) + (uint64_t)header.lightBlocks * chunkArea;
+    header.tilesOffset = AlignUp(lightEnd, tileAlignment);
+    header.fileSize = header.tilesOffset + (uint64_t)chunkCount * chunkArea;
+
+    PlayerRecord playerRecord{};
+    playerRecord.x = player.x;
+    playerRecord.y = player.y;
+    playerRecord.vx = player.vx;
+    playerRecord.vy = player.vy;
+    playerRecord.spawnX = player.spawnX;
+    playerRecord.spawnY = player.spawnY;
+    playerRecord.health = player.health;
+    playerRecord.isDead = player.isDead;
+    playerRecord.faceDir = player.faceDir;
+
+    std::error_code ec;
+    std::filesystem::path savePath(path);
+    if (savePath.has_parent_path()) std::filesystem::create_directories(savePath.parent_path(), ec);
+
+    // Write next to the old save and swap it in, a loaded world may still map the old file
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cout << "Failed to open save file: " << tempPath << std::endl;
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&playerRecord), sizeof(playerRecord));
+        out.write(reinterpret_cast<const char*>(dropped.data()), dropped.size() * sizeof(ItemRecord));
+        out.write(reinterpret_cast<const char*>(carried.data()), carried.size() * sizeof(ItemRecord));
+        world.WriteChunkFlags(out);
+        std::vector<char> padding(header.indexOffset - (header.flagsOffset + chunkCount), 0);
+        out.write(padding.data(), padding.size());
+        world.WriteIndexes(out);
+        world.WriteLight(out);
+
+        padding.assign(header.tilesOffset - lightEnd, 0);
+        out.write(padding.data(), padding.size());
+        world.WriteTiles(out);
+
+        if (!out) {
+            std::cout << "Failed to write save file: " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::cout << "Failed to replace save file: " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SaveManager::Load(World& world, Player& player, Inventory& inventory) const {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->Open(path)) return false;
+
+    if (file->size() < sizeof(SaveHeader)) {
+        std::cout << "Save file is too small: " << path << std::endl;
+        return false;
+    }
+
+    SaveHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, saveMagic, sizeof(saveMagic)) != 0 || header.version != saveVersion) {
+        std::cout << "Unsupported save file: " << path << std::endl;
+        return false;
+    }
+    if (header.width != world.getWidth() || header.height != world.getHeight() ||
+        header.chunkSize != chunkSize || header.fileSize != file->size()) {
+        std::cout << "Save file does not match this world layout: " << path << std::endl;
+        return false;
+    }
+    uint64_t chunkCount = (uint64_t)world.getChunksX() * world.getChunksY();
+    if (header.chunksX != world.getChunksX() || header.chunksY != world.getChunksY() ||
+        header.chunksX != (header.width + chunkSize - 1) / chunkSize ||
+        header.chunksY != (header.height + chunkSize - 1) / chunkSize ||
+        !FitsInFile(header.playerOffset, 1, sizeof(PlayerRecord), header.fileSize) ||
+        !FitsInFile(header.itemsOffset, header.itemCount, sizeof(ItemRecord), header.fileSize) ||
+        !FitsInFile(header.inventoryOffset, header.inventoryCount, sizeof(ItemRecord), header.fileSize) ||
+        !FitsInFile(header.flagsOffset, chunkCount, 1, header.fileSize) ||
+        !FitsInFile(header.indexOffset, 1, world.getSavedIndexBytes(), header.fileSize) ||
+        !FitsInFile(header.lightOffset, chunkCount, sizeof(uint32_t), header.fileSize) ||
+        !FitsInFile(header.lightOffset + chunkCount * sizeof(uint32_t), header.lightBlocks, chunkArea, header.fileSize) ||
+        !FitsInFile(header.tilesOffset, chunkCount, chunkArea, header.fileSize)) {
+        std::cout << "Save file is truncated or corrupt: " << path << std::endl;
+        return false;
+    }
+    for (uint64_t i = 0; i < chunkCount; ++i) {
+        uint32_t entry;
+        std::memcpy(&entry, file->data() + header.lightOffset + i * sizeof(entry), sizeof(entry));
+        if (!(entry & World::savedUniformLight) && entry >= header.lightBlocks) {
+            std::cout << "Save file is truncated or corrupt: " << path << std::endl;
+            return false;
+        }
+    }
+    // Tiles index the tile table and surface rows are used as rows, so neither may be out of range
+    for (int i = 0; i < 2 * header.width; ++i) { // topSolid then topNonAir
+        int32_t row;
+        std::memcpy(&row, file->data() + header.indexOffset + i * sizeof(row), sizeof(row));
+        if (row < -1 || row >= header.height) {
+            std::cout << "Save file is truncated or corrupt: " << path << std::endl;
+            return false;
+        }
+    }
+    if (!AllBelow(file->data() + header.tilesOffset, chunkCount * chunkArea, World::TILE_COUNT)) {
+        std::cout << "Save file is truncated or corrupt: " << path << std::endl;
+        return false;
+    }
+
+    PlayerRecord playerRecord;
+    std::memcpy(&playerRecord, file->data() + header.playerOffset, sizeof(playerRecord));
+    player.x = playerRecord.x;
+    player.y = playerRecord.y;
+    player.vx = playerRecord.vx;
+    player.vy = playerRecord.vy;
+    player.spawnX = playerRecord.spawnX;
+    player.spawnY = playerRecord.spawnY;
+    player.health = playerRecord.health;
+    player.isDead = playerRecord.isDead;
+    player.faceDir = playerRecord.faceDir;
+    player.StartFallDamageTimer(1.5f);
+
+    ItemManager::items.clear();
+    for (uint32_t i = 0; i < header.itemCount; ++i) {
+        ItemRecord record;
+        std::memcpy(&record, file->data() + header.itemsOffset + i * sizeof(ItemRecord), sizeof(record));
+        ItemManager::ReserveId(record.id);
+        ItemManager::AddItemToWorld(FromRecord(record, Item::DROPPED));
+    }
+
+    inventory.inventory.clear();
+    inventory.currentWeight = 0;
+    for (uint32_t i = 0; i < header.inventoryCount; ++i) {
+        ItemRecord record;
+        std::memcpy(&record, file->data() + header.inventoryOffset + i * sizeof(ItemRecord), sizeof(record));
+        ItemManager::ReserveId(record.id);
+        Item item = FromRecord(record, Item::INVENTORY);
+        inventory.AddItemToInventory(item);
+    }
+
+    World::SaveLayout layout{ header.tilesOffset, header.flagsOffset, header.indexOffset, header.lightOffset };
+    world.UseMappedTiles(std::move(file), layout, header.seed, header.originChunkX);
+    return true;
+}
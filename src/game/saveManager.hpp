@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include "../world/world.hpp"
+#include "../player/player.hpp"
+#include "../player/inventory.hpp"
+
+// Versioned binary save of the world, player, inventory and dropped items.
+//
+// Layout: SaveHeader, player record, dropped item records, inventory item records,
+// one edited flag per chunk, then (page aligned) the raw tiles of every chunk in
+// chunk index order. Loading maps the file and hands the tile block to World as is.
+class SaveManager {
+public:
+    explicit SaveManager(std::string path = "saves/world.sav");
+
+    bool Save(const World& world, const Player& player, const Inventory& inventory) const;
+    bool Load(World& world, Player& player, Inventory& inventory) const;
+    bool Exists() const;
+
+private:
+    std::string path;
+};
@@ -0,0 +1,328 @@
+#include "physicsSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include "tileSweep.hpp"
+
+extern int tileSize;
+
+PhysicsSystem::BodyId PhysicsSystem::Add(float bodyX, float bodyY, float bodyWidth, float bodyHeight, MaterialId kind) {
+    BodyId id;
+    if (freeIds.empty()) {
+        id = (BodyId)indices.size();
+        indices.push_back(-1);
+    } else {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+
+    indices[id] = (int)ids.size();
+    ids.push_back(id);
+    x.push_back(bodyX);
+    y.push_back(bodyY);
+    prevX.push_back(bodyX);
+    prevY.push_back(bodyY);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    width.push_back(bodyWidth);
+    height.push_back(bodyHeight);
+    impactVy.push_back(0.0f);
+    material.push_back(kind);
+    flags.push_back(0);
+    suspendedAt.push_back(0.0);
+    owner.push_back(0);
+
+    // New bodies start awake
+    int index = getBodyCount() - 1;
+    if (index != awakeCount) m_SwapBodies(index, awakeCount);
+    ++awakeCount;
+    return id;
+}
+
+// The body is moved to the end and dropped, first out of the awake ones if it was awake
+void PhysicsSystem::Remove(BodyId id) {
+    int index = IndexOf(id);
+    if (index < 0) return;
+
+    if (index < awakeCount) {
+        m_SwapBodies(index, awakeCount - 1);
+        index = --awakeCount;
+    } else {
+        m_RemoveFromCell(index);
+    }
+    m_SwapBodies(index, getBodyCount() - 1);
+
+    auto dropLast = [](auto& values) { values.pop_back(); };
+    dropLast(x);
+    dropLast(y);
+    dropLast(prevX);
+    dropLast(prevY);
+    dropLast(vx);
+    dropLast(vy);
+    dropLast(width);
+    dropLast(height);
+    dropLast(impactVy);
+    dropLast(material);
+    dropLast(flags);
+    dropLast(suspendedAt);
+    dropLast(owner);
+    dropLast(ids);
+
+    indices[id] = -1;
+    freeIds.push_back(id);
+}
+
+void PhysicsSystem::m_SwapBodies(int a, int b) {
+    if (a == b) return;
+    auto swapAt = [a, b](auto& values) { std::swap(values[a], values[b]); };
+    swapAt(x);
+    swapAt(y);
+    swapAt(prevX);
+    swapAt(prevY);
+    swapAt(vx);
+    swapAt(vy);
+    swapAt(width);
+    swapAt(height);
+    swapAt(impactVy);
+    swapAt(material);
+    swapAt(flags);
+    swapAt(suspendedAt);
+    swapAt(owner);
+    swapAt(ids);
+    indices[ids[a]] = a;
+    indices[ids[b]] = b;
+}
+
+int PhysicsSystem::IndexOf(BodyId id) const {
+    return id < indices.size() ? indices[id] : -1;
+}
+
+int PhysicsSystem::getBodyCount() const { return (int)ids.size(); }
+int PhysicsSystem::getAwakeCount() const { return awakeCount; }
+
+bool PhysicsSystem::IsAwake(BodyId id) const {
+    int index = IndexOf(id);
+    return index >= 0 && index < awakeCount;
+}
+
+void PhysicsSystem::Sleep(BodyId id) {
+    int index = IndexOf(id);
+    if (index < 0 || index >= awakeCount) return;
+    m_SwapBodies(index, --awakeCount);
+    m_AddToCell(awakeCount);
+}
+
+void PhysicsSystem::Wake(BodyId id) {
+    int index = IndexOf(id);
+    if (index < awakeCount || (flags[index] & BODY_SUSPENDED)) return;
+    m_RemoveFromCell(index);
+    m_SwapBodies(index, awakeCount++);
+}
+
+int PhysicsSystem::WakeWithin(float centerX, float centerY, float radius) {
+    m_FindInCells(sleepingCells, centerX - radius, centerY - radius, centerX + radius, centerY + radius, [&](int i) {
+        float dx = x[i] - centerX;
+        float dy = y[i] - centerY;
+        return dx * dx + dy * dy <= radius * radius;
+    });
+    for (BodyId id : wakeScratch) Wake(id);
+    return (int)wakeScratch.size();
+}
+
+int PhysicsSystem::WakeOverlapping(float x0, float y0, float x1, float y1) {
+    m_FindInCells(sleepingCells, x0 - maxSleeperSize, y0 - maxSleeperSize, x1, y1, [&](int i) {
+        return x[i] < x1 && x[i] + width[i] > x0 && y[i] < y1 && y[i] + height[i] > y0;
+    });
+    for (BodyId id : wakeScratch) Wake(id);
+    return (int)wakeScratch.size();
+}
+
+const std::vector<PhysicsSystem::BodyId>& PhysicsSystem::SleepingOverlapping(float x0, float y0, float x1, float y1) {
+    m_FindInCells(sleepingCells, x0 - maxSleeperSize, y0 - maxSleeperSize, x1, y1, [&](int i) {
+        return x[i] < x1 && x[i] + width[i] > x0 && y[i] < y1 && y[i] + height[i] > y0;
+    });
+    return wakeScratch;
+}
+
+void PhysicsSystem::Suspend(BodyId id) {
+    int index = IndexOf(id);
+    if (index < 0 || index >= awakeCount) return;
+    m_SwapBodies(index, --awakeCount);
+    flags[awakeCount] |= BODY_SUSPENDED;
+    suspendedAt[awakeCount] = clock;
+    m_AddToCell(awakeCount);
+}
+
+int PhysicsSystem::ResumeOverlapping(float x0, float y0, float x1, float y1, const World& world) {
+    m_FindInCells(suspendedCells, x0 - maxSleeperSize, y0 - maxSleeperSize, x1, y1, [&](int i) {
+        return x[i] < x1 && x[i] + width[i] > x0 && y[i] < y1 && y[i] + height[i] > y0;
+    });
+    for (BodyId id : wakeScratch) {
+        int index = IndexOf(id);
+        m_RemoveFromCell(index);
+        flags[index] &= ~BODY_SUSPENDED;
+        m_SwapBodies(index, awakeCount);
+        m_Settle(awakeCount, (float)(clock - suspendedAt[awakeCount]), world);
+        ++awakeCount;
+    }
+    return (int)wakeScratch.size();
+}
+
+// Where the body would be after elapsed seconds on its own, in one go: friction slows it
+// sideways to a stop, and it rises against gravity plus friction, then falls with gravity
+// less friction up to its fall speed. Each axis is swept once over the whole distance.
+void PhysicsSystem::m_Settle(int index, float elapsed, const World& world) {
+    const Material& kind = materials[material[index]];
+
+    float speedX = std::fabs(vx[index]);
+    float slide = kind.friction > 0.0f ? std::min(elapsed, speedX / kind.friction) : elapsed;
+    float dx = std::copysign(speedX * slide - 0.5f * kind.friction * slide * slide, vx[index]);
+    float endVx = std::copysign(std::max(speedX - kind.friction * elapsed, 0.0f), vx[index]);
+
+    float dy = 0.0f;
+    float v = vy[index];
+    float left = elapsed;
+    if (v < 0.0f) {
+        float rise = kind.gravity + kind.friction;
+        float t = std::min(left, -v / rise);
+        dy += v * t + 0.5f * rise * t * t;
+        v += rise * t;
+        left -= t;
+    }
+    float fall = kind.gravity - kind.friction;
+    if (left > 0.0f && fall > 0.0f) {
+        float t = std::min(left, std::max((kind.maxFallSpeed - v) / fall, 0.0f));
+        dy += v * t + 0.5f * fall * t * t;
+        v += fall * t;
+        left -= t;
+    }
+    dy += v * left;
+
+    bool hit;
+    x[index] += SweepX(world, x[index], y[index], width[index], height[index], dx, hit);
+    vx[index] = hit ? 0.0f : endVx;
+    y[index] += SweepY(world, x[index], y[index], width[index], height[index], dy, hit);
+    vy[index] = hit ? 0.0f : v;
+    prevX[index] = x[index];
+    prevY[index] = y[index];
+}
+
+// Filed bodies go under the cell holding their top left corner. Fills wakeScratch with
+// the matching ones, since waking them reorders the cells.
+template <typename Match>
+void PhysicsSystem::m_FindInCells(const CellMap& cells, float x0, float y0, float x1, float y1, Match match) {
+    wakeScratch.clear();
+    if (cells.empty()) return;
+
+    float cellPixels = (float)(chunkSize * tileSize);
+    int cellX0 = (int)std::floor(x0 / cellPixels);
+    int cellY0 = (int)std::floor(y0 / cellPixels);
+    int cellX1 = (int)std::floor(x1 / cellPixels);
+    int cellY1 = (int)std::floor(y1 / cellPixels);
+
+    auto matchAll = [&](const std::vector<BodyId>& cellIds) {
+        for (BodyId id : cellIds) {
+            if (match(IndexOf(id))) wakeScratch.push_back(id);
+        }
+    };
+
+    // A rectangle wider than what is filed is cheaper to answer from the filed cells
+    if ((double)(cellX1 - cellX0 + 1) * (cellY1 - cellY0 + 1) > (double)cells.size()) {
+        for (const auto& cell : cells) {
+            int cellX = (int32_t)(uint32_t)cell.first;
+            int cellY = (int)(cell.first >> 32);
+            if (cellX >= cellX0 && cellX <= cellX1 && cellY >= cellY0 && cellY <= cellY1) matchAll(cell.second);
+        }
+        return;
+    }
+
+    for (int cellY = cellY0; cellY <= cellY1; ++cellY) {
+        for (int cellX = cellX0; cellX <= cellX1; ++cellX) {
+            auto cell = cells.find(m_CellKey(cellX * cellPixels, cellY * cellPixels));
+            if (cell != cells.end()) matchAll(cell->second);
+        }
+    }
+}
+
+int64_t PhysicsSystem::m_CellKey(float cellX, float cellY) const {
+    float cellPixels = (float)(chunkSize * tileSize);
+    int64_t column = (int64_t)std::floor(cellX / cellPixels);
+    int64_t row = (int64_t)std::floor(cellY / cellPixels);
+    return (int64_t)((uint64_t)row << 32 | (uint32_t)column);
+}
+
+PhysicsSystem::CellMap& PhysicsSystem::m_CellsOf(int index) {
+    return flags[index] & BODY_SUSPENDED ? suspendedCells : sleepingCells;
+}
+
+void PhysicsSystem::m_AddToCell(int index) {
+    maxSleeperSize = std::max({ maxSleeperSize, width[index], height[index] });
+    m_CellsOf(index)[m_CellKey(x[index], y[index])].push_back(ids[index]);
+}
+
+void PhysicsSystem::m_RemoveFromCell(int index) {
+    CellMap& cells = m_CellsOf(index);
+    auto cell = cells.find(m_CellKey(x[index], y[index]));
+    if (cell == cells.end()) return;
+
+    std::vector<BodyId>& cellIds = cell->second;
+    auto found = std::find(cellIds.begin(), cellIds.end(), ids[index]);
+    if (found == cellIds.end()) return;
+    *found = cellIds.back();
+    cellIds.pop_back();
+    if (cellIds.empty()) cells.erase(cell);
+}
+
+// One pass over the awake bodies, each in the order the player and items used to run on
+// their own: gravity, a swept move on each axis (a hit stops that axis), then friction
+void PhysicsSystem::Step(float deltaTime, const World& world) {
+    ++stepCount;
+    clock += deltaTime;
+
+    for (int i = 0; i < awakeCount; ++i) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+        flags[i] &= ~(BODY_HIT_X | BODY_HIT_Y);
+        if (!(flags[i] & BODY_ACTIVE)) continue;
+
+        float bodyDt = deltaTime;
+        if (flags[i] & BODY_COARSE) {
+            if ((stepCount + ids[i]) % coarseTicks != 0) continue;
+            bodyDt = deltaTime * coarseTicks;
+        }
+
+        // Locals, so the calls below don't force every field to be reloaded
+        const Material& kind = materials[material[i]];
+        float bodyX = x[i];
+        float bodyY = y[i];
+        float bodyVx = vx[i];
+        float bodyVy = std::min(vy[i] + kind.gravity * bodyDt, kind.maxFallSpeed);
+
+        bool hit;
+        bodyX += SweepX(world, bodyX, bodyY, width[i], height[i], bodyVx * bodyDt, hit);
+        if (hit) {
+            flags[i] |= BODY_HIT_X;
+            bodyVx = 0.0f;
+        }
+        bodyY += SweepY(world, bodyX, bodyY, width[i], height[i], bodyVy * bodyDt, hit);
+        if (hit) {
+            flags[i] |= BODY_HIT_Y;
+            impactVy[i] = bodyVy;
+            bodyVy = 0.0f;
+        }
+
+        float friction = kind.friction * bodyDt;
+        x[i] = bodyX;
+        y[i] = bodyY;
+        vx[i] = std::copysign(std::max(std::fabs(bodyVx) - friction, 0.0f), bodyVx);
+        vy[i] = std::copysign(std::max(std::fabs(bodyVy) - friction, 0.0f), bodyVy);
+    }
+}
+
+void PhysicsSystem::Shift(float dx) {
+    for (float& value : x) value -= dx;
+    for (float& value : prevX) value -= dx;
+
+    sleepingCells.clear();
+    suspendedCells.clear();
+    for (int i = awakeCount; i < getBodyCount(); ++i) m_AddToCell(i);
+}
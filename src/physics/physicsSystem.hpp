@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../world/world.hpp"
+
+// Every moving body in the game, the player and each dropped item alike, kept as
+// parallel arrays so a step walks memory in order: gravity for every body, then the tile
+// sweeps, then friction. A body is named by its BodyId, which stays valid while others
+// come and go; IndexOf turns it into the array index, good until bodies are added,
+// removed, put to sleep or woken.
+//
+// Bodies at rest can sleep. The awake ones fill the front of the arrays and are all Step
+// walks; sleepers sit after them, bucketed by area so the wake queries only look nearby.
+// Bodies too far from anything that matters can be suspended the same way, at rest or
+// not, and are moved on analytically for the time they missed when they are resumed.
+class PhysicsSystem {
+public:
+    using BodyId = uint32_t;
+    static constexpr BodyId noBody = 0xFFFFFFFFu;
+
+    // Shared by every body of a kind rather than copied into each one
+    struct Material {
+        float gravity;      // px/s^2
+        float maxFallSpeed; // px/s
+        float friction;     // px/s^2 taken off each axis of the velocity, never past zero
+    };
+    enum MaterialId : uint8_t {
+        MATERIAL_PLAYER,
+        MATERIAL_ITEM,
+        MATERIAL_COUNT
+    };
+    static constexpr Material materials[MATERIAL_COUNT] = {
+        { 1200.0f, 10000.0f, 0.0f },   // MATERIAL_PLAYER, steered by input instead
+        { 1200.0f, 10000.0f, 350.0f }, // MATERIAL_ITEM
+    };
+
+    enum BodyFlags : uint8_t {
+        BODY_ACTIVE = 1 << 0,    // stepped; an inactive body keeps its state untouched
+        BODY_HIT_X = 1 << 1,     // the last step stopped it against a tile, on that axis
+        BODY_HIT_Y = 1 << 2,
+        BODY_COARSE = 1 << 3,    // stepped once every coarseTicks ticks, covering all of them
+        BODY_SUSPENDED = 1 << 4, // out of the awake bodies until ResumeOverlapping
+    };
+    static constexpr int coarseTicks = 4; // coarse bodies take turns, so each tick steps a share
+
+    BodyId Add(float bodyX, float bodyY, float bodyWidth, float bodyHeight, MaterialId kind);
+    void Remove(BodyId id);
+    int IndexOf(BodyId id) const;
+    int getBodyCount() const;
+    int getAwakeCount() const; // bodies at indices below this are awake
+
+    void Sleep(BodyId id);
+    void Wake(BodyId id);
+    bool IsAwake(BodyId id) const;
+    // Wake every sleeper whose position is within radius of the center, or whose box
+    // overlaps the rectangle. Both return how many woke.
+    int WakeWithin(float centerX, float centerY, float radius);
+    int WakeOverlapping(float x0, float y0, float x1, float y1);
+    // The sleepers whose box overlaps the rectangle, left asleep. Good until the next query.
+    const std::vector<BodyId>& SleepingOverlapping(float x0, float y0, float x1, float y1);
+
+    void Suspend(BodyId id);
+    // Resume every suspended body whose box overlaps the rectangle, settled where it would
+    // be by now. Returns how many resumed.
+    int ResumeOverlapping(float x0, float y0, float x1, float y1, const World& world);
+
+    void Step(float deltaTime, const World& world);
+    void Shift(float dx); // the world's origin moved by dx pixels
+
+    // One entry per body, at IndexOf(id)
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY; // position before the latest step
+    std::vector<float> vx, vy;
+    std::vector<float> width, height;
+    std::vector<float> impactVy; // vy as the last step's BODY_HIT_Y stopped it
+    std::vector<uint8_t> material;
+    std::vector<uint8_t> flags;
+    std::vector<double> suspendedAt; // step clock when it was suspended
+    std::vector<uint32_t> owner; // left to whoever added the body, to find its own record
+
+private:
+    std::vector<BodyId> ids;  // per index
+    std::vector<int> indices; // per id, -1 while the id is free
+    std::vector<BodyId> freeIds;
+
+    int awakeCount = 0;
+    uint32_t stepCount = 0;
+    double clock = 0.0; // seconds stepped so far
+
+    // Bodies out of the awake ones, filed by the chunk-sized area their corner is in
+    using CellMap = std::unordered_map<int64_t, std::vector<BodyId>>;
+    CellMap sleepingCells;
+    CellMap suspendedCells;
+    float maxSleeperSize = 0.0f; // how far a filed body's box can reach past its cell
+    std::vector<BodyId> wakeScratch;
+
+    void m_SwapBodies(int a, int b);
+    int64_t m_CellKey(float cellX, float cellY) const;
+    CellMap& m_CellsOf(int index);
+    void m_AddToCell(int index);
+    void m_RemoveFromCell(int index);
+    template <typename Match>
+    void m_FindInCells(const CellMap& cells, float x0, float y0, float x1, float y1, Match match);
+    void m_Settle(int index, float elapsed, const World& world);
+};
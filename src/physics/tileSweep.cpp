@@ -0,0 +1,61 @@
+#include "tileSweep.hpp"
+#include <algorithm>
+#include <cmath>
+
+extern int tileSize;
+
+// Tile span a box covers along one axis; the far edge is pulled in a hair, so a box
+// resting flush against a tile does not count as inside it. A contact can come
+// out a hair behind the box when it sat that far inside a tile, which snaps it flush.
+static int FirstTile(float start) { return (int)std::floor(start / tileSize); }
+static int LastTile(float start, float size) { return (int)std::floor((start + size - 0.01f) / tileSize); }
+
+float SweepX(const World& world, float x, float y, float w, float h, float dx, bool& hit) {
+    hit = false;
+    if (dx == 0.0f) return 0.0f;
+
+    int row0 = FirstTile(y);
+    int row1 = LastTile(y, h);
+    if (dx > 0.0f) {
+        int from = LastTile(x, w) + 1;
+        int to = LastTile(x + dx, w);
+        int column = to >= from ? world.FindSolidColumn(row0, row1, from, to) : -1;
+        if (column < 0) return dx;
+        hit = true;
+        return std::min(column * tileSize - w - x, dx);
+    }
+
+    int from = FirstTile(x) - 1;
+    int to = FirstTile(x + dx);
+    int column = to <= from ? world.FindSolidColumn(row0, row1, from, to) : -1;
+    if (column < 0) return dx;
+    hit = true;
+    return std::max((column + 1) * tileSize - x, dx);
+}
+
+float SweepY(const World& world, float x, float y, float w, float h, float dy, bool& hit) {
+    hit = false;
+    if (dy == 0.0f) return 0.0f;
+
+    int column0 = FirstTile(x);
+    int column1 = LastTile(x, w);
+    if (dy > 0.0f) {
+        int from = LastTile(y, h) + 1;
+        int to = LastTile(y + dy, h);
+        int row = to >= from ? world.FindSolidRow(column0, column1, from, to) : -1;
+        if (row < 0) return dy;
+        hit = true;
+        return std::min(row * tileSize - h - y, dy);
+    }
+
+    int from = FirstTile(y) - 1;
+    int to = FirstTile(y + dy);
+    int row = to <= from ? world.FindSolidRow(column0, column1, from, to) : -1;
+    if (row < 0) return dy;
+    hit = true;
+    return std::max((row + 1) * tileSize - y, dy);
+}
+
+bool OverlapsSolid(const World& world, float x, float y, float w, float h) {
+    return world.AnySolid(FirstTile(x), FirstTile(y), LastTile(x, w), LastTile(y, h));
+}
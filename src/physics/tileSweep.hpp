@@ -0,0 +1,12 @@
+#pragma once
+#include "../world/world.hpp"
+
+// Swept collision of an axis-aligned box against the solid tiles, one axis at a time.
+// The box [x, x + w) x [y, y + h) moves by up to d along the axis and stops flush
+// against the first solid tile in its way. Returns the distance actually moved and sets
+// hit when a tile stopped it. Tiles the box already overlaps are not in its way.
+float SweepX(const World& world, float x, float y, float w, float h, float dx, bool& hit);
+float SweepY(const World& world, float x, float y, float w, float h, float dy, bool& hit);
+
+// Whether the box overlaps a solid tile, counted the same way the sweeps count contact
+bool OverlapsSolid(const World& world, float x, float y, float w, float h);
@@ -1,45 +1,60 @@
 #include "blockEditor.hpp"
 #include <iostream>
 #include <raylib.h>
+#include "../render/drawBackend.hpp"
+
+// World's tile table stores drop items as plain ints since world.hpp can't see Item
+static_assert(World::GetTileInfo(World::TILE_STONE).dropItem == Item::BLOCK_STONE, "tile table out of sync");
+static_assert(World::GetTileInfo(World::TILE_DIRT).dropItem == Item::BLOCK_DIRT, "tile table out of sync");
+static_assert(World::GetTileInfo(World::TILE_TREE_TRUNK).dropItem == Item::BLOCK_TREE_TRUNK, "tile table out of sync");
+static_assert(World::GetTileInfo(World::TILE_TREE_LEAVES).dropItem == Item::BLOCK_TREE_LEAVES, "tile table out of sync");
 
 BlockEditor::BlockEditor(World& world, const GameCamera& camera)
     : world(world), camera(camera) {}
 
+// Frames and ticks don't line up, so a click between two ticks, or a drag across several
+// tiles, is kept here until the next tick rather than read from the mouse there
+void BlockEditor::PollInput() {
+    int tileX, tileY;
+    if (!IsMouseButtonDown(MOUSE_LEFT_BUTTON) && !IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) return;
+    if (!GetHoveredTile(tileX, tileY)) return;
+    if (queuedTiles.empty() || queuedTiles.back() != std::make_pair(tileX, tileY)) {
+        queuedTiles.push_back({ tileX, tileY });
+    }
+}
+
 void BlockEditor::Update(Player& player, ItemManager& itemManager) {
-    if (IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-        int tileX, tileY;
-        if (GetHoveredTile(tileX, tileY)) {
-            double dist = findDistance(tileX, tileY, player.x / tileSize, player.y / tileSize);
-            if (dist <= blockReach && world.IsTile(tileX, tileY)) {
-                if (tileX >= 0 && tileX < world.getWidth() &&
-                    tileY >= 0 && tileY < world.getHeight()) {
-
-                    int tileType = world.GetTileAtWorldPixel(tileX * tileSize, tileY * tileSize);
-
-                    if (tileType == World::TILE_DIRT || tileType == World::TILE_DIRT_GRASS) {
-                        itemManager.CreateDroppedItem("Dirt", tileX * tileSize, tileY * tileSize, 1, Item::BLOCK_DIRT);
-                    } else if (tileType == World::TILE_STONE) {
-                        itemManager.CreateDroppedItem("Stone", tileX * tileSize, tileY * tileSize, 1, Item::BLOCK_STONE); 
-                    } else if (tileType == World::TILE_TREE_TRUNK) {
-                        itemManager.CreateDroppedItem("Wood", tileX * tileSize, tileY * tileSize, 1, Item::BLOCK_TREE_TRUNK); 
-                    } else if (tileType == World::TILE_TREE_LEAVES) {
-                        itemManager.CreateDroppedItem("Leaves", tileX * tileSize, tileY * tileSize, 1, Item::BLOCK_TREE_LEAVES); 
-                    }
-
-                    world.at(tileX, tileY) = World::TILE_AIR; // Change destroyed tile to air
-                }
-            }
-        }
+    for (auto [tileX, tileY] : queuedTiles) {
+        double dist = findDistance(tileX, tileY, player.x / tileSize, player.y / tileSize);
+        if (dist <= blockReach) MineTile(tileX, tileY, itemManager);
     }
+    queuedTiles.clear();
+}
+
+bool BlockEditor::MineTile(int tileX, int tileY, ItemManager& itemManager) {
+    if (!world.IsTile(tileX, tileY)) return false; // also off the world or still generating
+
+    int tileType = world.GetTileAtWorldPixel(tileX * tileSize, tileY * tileSize);
+    const World::TileInfo& info = World::GetTileInfo(tileType);
+
+    if (info.dropItem >= 0) {
+        itemManager.CreateDroppedItem(info.dropName, tileX * tileSize, tileY * tileSize, 1,
+                                      static_cast<Item::ItemRenderType>(info.dropItem));
+    }
+
+    world.SetTile(tileX, tileY, World::TILE_AIR); // Change destroyed tile to air
+    itemManager.WakeItemsNear(tileX, tileY);
+    return info.dropItem >= 0;
 }
 
 void BlockEditor::DrawHighlight(Player& player) const {
+    DrawBackend& backend = GetDrawBackend();
     int tileX, tileY;
     if (GetHoveredTile(tileX, tileY)) {
         double dist = findDistance(tileX, tileY, player.x / tileSize, player.y / tileSize);
         if (dist <= blockReach) {
             if (world.IsTile(tileX, tileY)) {
-                DrawRectangle(
+                backend.DrawRectangle(
                     tileX * tileSize - camera.drawX,
                     tileY * tileSize - camera.drawY,
                     tileSize,
@@ -47,7 +62,7 @@ void BlockEditor::DrawHighlight(Player& player) const {
                     Fade(YELLOW, 0.3f)
                 );
 
-                DrawRectangleLines(
+                backend.DrawRectangleLines(
                     tileX * tileSize - camera.drawX,
                     tileY * tileSize - camera.drawY,
                     tileSize,
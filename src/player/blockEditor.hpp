@@ -6,18 +6,25 @@
 #include "../game/itemManager.hpp"
 #include "../util/utils.hpp"
 #include "raylib.h"
+#include <utility>
+#include <vector>
 
 class BlockEditor {
 public:
     BlockEditor(World& world, const GameCamera& camera);
 
-    void Update(Player& player, ItemManager& itemManager);
+    void PollInput(); // every frame: queues the hovered tile while the button is held
+    void Update(Player& player, ItemManager& itemManager); // every tick: mines the queued tiles in reach
+    // Drops a breakable tile's item, turns it to air and wakes the items around it.
+    // Returns whether an item was dropped.
+    bool MineTile(int tileX, int tileY, ItemManager& itemManager);
     void DrawHighlight(Player& player) const;
 
 private:
     World& world;
     const GameCamera& camera;
     int blockReach = 5;
+    std::vector<std::pair<int, int>> queuedTiles; // since the last tick, oldest first
 
     bool GetHoveredTile(int& outTileX, int& outTileY) const;
     int GetHoveredTileType() const;
@@ -6,6 +6,9 @@ void GameCamera::Follow(float targetX, float targetY, float deltaTime, int scree
 
     float lerpSpeed = 8.0f;
 
+    prevX = x;
+    prevY = y;
+
     x += (targetCamX - x) * lerpSpeed * deltaTime;
     y += (targetCamY - y) * lerpSpeed * deltaTime;
 
@@ -13,8 +16,12 @@ void GameCamera::Follow(float targetX, float targetY, float deltaTime, int scree
     x = std::clamp(x, 0.0f, std::max(0.0f, (float)(worldPixelWidth - screenWidth)));
     y = std::clamp(y, 0.0f, std::max(0.0f, (float)(worldPixelHeight - screenHeight)));
 
+    Interpolate(1.0f);
+}
+
+void GameCamera::Interpolate(float alpha) {
     // Snap for rendering
-    drawX = (int)std::floor(x);
-    drawY = (int)std::floor(y);
+    drawX = (int)std::floor(prevX + (x - prevX) * alpha);
+    drawY = (int)std::floor(prevY + (y - prevY) * alpha);
 }
 
@@ -6,11 +6,14 @@
 struct GameCamera {
     float x = 0;
     float y = 0;
+    float prevX = 0; // position before the latest tick
+    float prevY = 0;
     float speed = 1800.0f;
 
-    int drawX = 0; // Integer-aligned position for rendering
+    int drawX = 0; // Integer-aligned position for rendering, between prev and the latest tick
     int drawY = 0;
 
     void Follow(float targetX, float targetY, float deltaTime, int screenWidth, int screenHeight, int worldPixelWidth, int worldPixelHeight);
+    void Interpolate(float alpha); // sets drawX / drawY, 0 at prev and 1 at the latest tick
 };
 
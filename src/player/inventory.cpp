@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include "../player/player.hpp"
 #include "../game/itemManager.hpp"
+#include "../render/drawBackend.hpp"
 
 
 void Inventory::Update(Player& player) {
@@ -40,6 +41,7 @@ void Inventory::Update(Player& player) {
 }
 
 void Inventory::Draw() {
+    DrawBackend& backend = GetDrawBackend();
     if (!isInventoryOpen) return;
 
     int panelX = 10;
@@ -48,23 +50,23 @@ void Inventory::Draw() {
     int panelHeight = maxVisibleLines * lineHeight + 30;
 
     // Draw background panel
-    DrawRectangle(panelX, panelY, panelWidth, panelHeight, Fade(BLACK, 0.7f));
-    DrawRectangleLines(panelX, panelY, panelWidth, panelHeight, DARKGRAY);
+    backend.DrawRectangle(panelX, panelY, panelWidth, panelHeight, Fade(BLACK, 0.7f));
+    backend.DrawRectangleLines(panelX, panelY, panelWidth, panelHeight, DARKGRAY);
 
     int x = panelX + 10;
     int y = panelY + 20 - scrollOffset;  // apply scroll offset here
 
-    DrawText("Inventory:", x, panelY + 5, 20, YELLOW);
+    backend.DrawText("Inventory:", x, panelY + 5, 20, YELLOW);
 
     if (inventory.empty()) {
-        DrawText("  (Empty)", x, y + 10, 20, LIGHTGRAY);
+        backend.DrawText("  (Empty)", x, y + 10, 20, LIGHTGRAY);
         return;
     }
 
     // Group items by name
     std::unordered_map<std::string, int> groupedCounts;
     for (const auto& item : inventory) {
-        groupedCounts[std::string(item.name)]++;
+        groupedCounts[std::string(item.name)] += item.count;
     }
 
     // Draw only visible lines
@@ -84,18 +86,18 @@ void Inventory::Draw() {
         // Draw item text
         std::stringstream ss;
         ss << "- " << name << " x" << count;
-        DrawText(ss.str().c_str(), x, lineY, 20, WHITE);
+        backend.DrawText(ss.str().c_str(), x, lineY, 20, WHITE);
 
         // Draw Drop button
         Rectangle dropBtn = { (float)(panelX + panelWidth - 60), (float)lineY, 50.0f, (float)(lineHeight - 4) };
-        DrawRectangleRec(dropBtn, GRAY);
-        DrawRectangleLinesEx(dropBtn, 1, DARKGRAY);
-        DrawText("Drop", dropBtn.x + 5, dropBtn.y + 2, 18, BLACK);
+        backend.DrawRectangleRec(dropBtn, GRAY);
+        backend.DrawRectangleLinesEx(dropBtn, 1, DARKGRAY);
+        backend.DrawText("Drop", dropBtn.x + 5, dropBtn.y + 2, 18, BLACK);
 
         // Mouse hover effect
         if (CheckCollisionPointRec(GetMousePosition(), dropBtn)) {
             hoveredItemIndex = lineIndex;
-            DrawRectangleRec(dropBtn, Fade(WHITE, 0.2f)); // subtle hover
+            backend.DrawRectangleRec(dropBtn, Fade(WHITE, 0.2f)); // subtle hover
         }
 
         lineIndex++;
@@ -106,7 +108,7 @@ void Inventory::Draw() {
     char weightText[64];
     snprintf(weightText, sizeof(weightText), "Weight: %.0f / %.0f", currentWeight, maxWeight);
     Color weightColor = (currentWeight > maxWeight) ? RED : GREEN;
-    DrawText(weightText, panelX + 10, weightY, 20, weightColor);
+    backend.DrawText(weightText, panelX + 10, weightY, 20, weightColor);
 }
 
 
@@ -120,9 +122,16 @@ bool Inventory::IsInventoryFull() {
     }
 }
 
+int Inventory::RoomFor(const Item& item) {
+    if (currentWeight >= maxWeight) return 0;
+    if (item.itemWeight <= 0) return item.count;
+    return std::min(item.count, (int)((maxWeight - currentWeight) / item.itemWeight));
+}
+
+// A stack picked up off the ground comes in whole, as one entry holding its count
 void Inventory::AddItemToInventory(Item& item) {
     inventory.push_back(item);
-    currentWeight += item.itemWeight;
+    currentWeight += item.itemWeight * item.count;
 }
 
 void Inventory::RemoveItemById(uint64_t itemId, Player& player) {
@@ -132,7 +141,7 @@ void Inventory::RemoveItemById(uint64_t itemId, Player& player) {
         });
 
     if (it != inventory.end()) {
-        currentWeight -= it->itemWeight;
+        currentWeight -= it->itemWeight * it->count;
 
         it->xPos = player.x + 30;
         it->yPos = player.y;
@@ -187,6 +196,8 @@ void Inventory::DropOneItemAtGroupedIndex(int groupedIndex, Player& player) {
     if (!indices.empty()) {
         size_t dropIndex = indices.back();
         Item dropItem = inventory[dropIndex];
+        dropItem.count = 1; // one off the stack, which keeps its id
+        if (inventory[dropIndex].count > 1) dropItem.id = ItemManager::GenerateUniqueId();
         
         int place = 30;
         int xspeed = 600;
@@ -208,7 +219,7 @@ void Inventory::DropOneItemAtGroupedIndex(int groupedIndex, Player& player) {
         dropItem.SetIgnorePickupTimer(2.0f);
 
         ItemManager::AddItemToWorld(std::move(dropItem));
-        inventory.erase(inventory.begin() + dropIndex);
+        if (--inventory[dropIndex].count == 0) inventory.erase(inventory.begin() + dropIndex);
     }
 }
 
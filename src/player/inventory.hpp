@@ -21,6 +21,7 @@ public:
     void Update(Player& player);
     void Draw();
     bool IsInventoryFull();
+    int RoomFor(const Item& item); // how many of its units still fit under maxWeight
     void AddItemToInventory(Item& item);
     void RemoveItemById(uint64_t itemId, Player& player);
     void ScrollUp();
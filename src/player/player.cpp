@@ -3,13 +3,15 @@
 #include <algorithm>
 #include <iostream>
 #include <raylib.h>
+#include "../physics/tileSweep.hpp"
+#include "../render/drawBackend.hpp"
 
 extern int tileSize;
 
 void Player::Init(const World& world) {
     FindSpawn(world);
-    x = spawnX;
-    y = spawnY;
+    x = prevX = spawnX;
+    y = prevY = spawnY;
     vy = 0;
     vx = 0;
     health = maxHealth;
@@ -20,15 +22,30 @@ void Player::Init(const World& world) {
     StartFallDamageTimer(1.5f);
 }
 
-void Player::Update(float deltaTime, const World& world) {
+void Player::PollInput() {
+    jumpQueued = jumpQueued || IsKeyPressed(KEY_SPACE);
+    respawnQueued = respawnQueued || IsKeyPressed(KEY_R);
+}
+
+void Player::Update(float deltaTime, const World& world, PhysicsSystem& physics) {
+    if (body == PhysicsSystem::noBody) {
+        body = physics.Add(x, y, width, height, PhysicsSystem::MATERIAL_PLAYER);
+    }
+    int index = physics.IndexOf(body);
+    physics.flags[index] &= ~PhysicsSystem::BODY_ACTIVE;
+
+    bool jumpPressed = jumpQueued;
+    bool respawnPressed = respawnQueued;
+    jumpQueued = respawnQueued = false;
+
     IgnoreFallDamage(deltaTime);
 
-    if (isDead && IsKeyPressed(KEY_R)) {
+    if (isDead && respawnPressed) {
         Respawn();
     } else if (isDead) {
         return; // causes all player updates to not function must be at top
     }
-    if (IsKeyPressed(KEY_R)) Respawn(); // For Testing Only
+    if (respawnPressed) Respawn(); // For Testing Only
     
     vx = 0;
     if (IsKeyDown(KEY_A)) {
@@ -40,65 +57,44 @@ void Player::Update(float deltaTime, const World& world) {
         vx = speed;
     }
 
-    if ((isOnGround || IsOnGroundWithTolerance(world)) && IsKeyPressed(KEY_SPACE)) {
+    if ((isOnGround || IsOnGroundWithTolerance(world)) && jumpPressed) {
         vy = -600.0f;
         isOnGround = false;
     }
 
-    vy += gravity * deltaTime;
-    if (vy > maxFallSpeed) vy = maxFallSpeed;
-
-    MoveX(vx * deltaTime, world);
-    MoveY(vy * deltaTime, world);
-    //std::cout << "x: " << x << " y: " << y << " vx: " << vx << " vy: " << vy << std::endl;
+    // Anything may have moved the player since the last step, so the body starts from here
+    physics.x[index] = x;
+    physics.y[index] = y;
+    physics.vx[index] = vx;
+    physics.vy[index] = vy;
+    physics.flags[index] |= PhysicsSystem::BODY_ACTIVE;
 }
 
-void Player::MoveX(float dx, const World& world) {
-    float sign = dx > 0 ? 1.0f : -1.0f;
-    float step = tileSize / 4.0f;
-    float moved = 0.0f;
-
-    while (std::abs(moved) < std::abs(dx)) {
-        float move = std::min(step, std::abs(dx - moved)) * sign;
-        x += move;
-        if (IsColliding(world)) {
-            x -= move;
-            vx = 0;
-            break;
-        }
-        moved += move;
+void Player::EndTick(const PhysicsSystem& physics) {
+    prevX = x;
+    prevY = y;
+    int index = physics.IndexOf(body);
+    if (index < 0 || !(physics.flags[index] & PhysicsSystem::BODY_ACTIVE)) return;
+
+    x = physics.x[index];
+    y = physics.y[index];
+    vx = physics.vx[index];
+    vy = physics.vy[index];
+    if (!(physics.flags[index] & PhysicsSystem::BODY_HIT_Y)) {
+        isOnGround = false;
+        return;
     }
-}
 
-void Player::MoveY(float dy, const World& world) {
-    float sign = dy > 0 ? 1.0f : -1.0f;
-    float step = tileSize / 4.0f;
-    float moved = 0.0f;
-
-    float preCollisionVy = vy;
-
-    while (std::abs(moved) < std::abs(dy)) {
-        float move = std::min(step, std::abs(dy - moved)) * sign;
-        y += move;
-        if (IsColliding(world)) {
-            y -= move;
-
-            // Fall Damage
-            if (dy > 0 && preCollisionVy > safeFallSpeed && !ignoreFallDamage) {
-                int damage = static_cast<int>((preCollisionVy - safeFallSpeed) * fallSpeedDamageScale);
-                if (preCollisionVy > (safeFallSpeed * 2)) damage = maxHealth;
-                TakeDamage(damage);
-            }
-
-            vy = 0;
-            if (dy > 0)
-                isOnGround = true;
-            return;
-        }
-        moved += move;
+    // Fall Damage
+    float impact = physics.impactVy[index];
+    if (impact > safeFallSpeed && !ignoreFallDamage) {
+        int damage = static_cast<int>((impact - safeFallSpeed) * fallSpeedDamageScale);
+        if (impact > (safeFallSpeed * 2)) damage = maxHealth;
+        TakeDamage(damage);
     }
 
-    isOnGround = false;
+    if (impact > 0)
+        isOnGround = true;
 }
 
 void Player::IgnoreFallDamage(float deltaTime) {
@@ -129,8 +125,8 @@ void Player::TakeDamage(int damage) {
 }
 
 void Player::Respawn() {
-    x = spawnX;
-    y = spawnY;
+    x = prevX = spawnX;
+    y = prevY = spawnY;
     vx = vy = 0;
     isDead = false;
     isOnGround = true;
@@ -139,43 +135,28 @@ void Player::Respawn() {
 }
 
 bool Player::IsOnGroundWithTolerance(const World& world, float tolerance) const {
-    return IsCollidingAt(x, y + height + tolerance, width, 0.1f, world);
+    return OverlapsSolid(world, x, y + height + tolerance, width, 0.1f);
 }
 
-bool Player::IsCollidingAt(float px, float py, float w, float h, const World& world) const {
-    int tileX0 = (int)floor(px / tileSize);
-    int tileY0 = (int)floor(py / tileSize);
-    int tileX1 = (int)floor((px + w - 0.01f) / tileSize);
-    int tileY1 = (int)floor((py + h - 0.01f) / tileSize);
-
-    for (int ty = tileY0; ty <= tileY1; ++ty) {
-        for (int tx = tileX0; tx <= tileX1; ++tx) {
-            if (world.IsSolidTile(tx, ty)) return true;
-        }
-    }
-    return false;
-}
-
-bool Player::IsColliding(const World& world) const {
-    return IsCollidingAt(x, y, width, height, world);
-}
-
-void Player::Draw(int camDrawX, int camDrawY) const {
+void Player::Draw(int camDrawX, int camDrawY, float interpolation) const {
     Color playerColor;
     if (ignoreFallDamage) {
         playerColor = GREEN; 
     } else {
         playerColor = RED;
     }
-    DrawRectangle((int)(x - camDrawX), (int)(y - camDrawY), (int)width, (int)height, playerColor);
+    float drawX = prevX + (x - prevX) * interpolation;
+    float drawY = prevY + (y - prevY) * interpolation;
+    GetDrawBackend().DrawRectangle((int)(drawX - camDrawX), (int)(drawY - camDrawY), (int)width, (int)height, playerColor);
 }
 
 void Player::DrawUI() {
+    DrawBackend& backend = GetDrawBackend();
     const int barWidth = 200;
     const int barHeight = 20;
     const int margin = 20;
 
-    int sw = GetScreenWidth();
+    int sw = backend.GetScreenWidth();
     //int sh = GetScreenHeight();
 
     // top right position
@@ -184,21 +165,21 @@ void Player::DrawUI() {
 
     // Health Bar
     float healthPercent = (float)health / maxHealth;
-    DrawRectangle(hBarX, hBarY, barWidth, barHeight, DARKGRAY); // background
-    DrawRectangle(hBarX, hBarY, (int)(barWidth * healthPercent), barHeight, RED); // Health
-    DrawRectangleLines(hBarX, hBarY, barWidth, barHeight, BLACK); // border
-    DrawText(TextFormat("HP: %d / %d", health, maxHealth), hBarX + (barWidth / 4), hBarY + (barHeight / 5), 14, WHITE);
+    backend.DrawRectangle(hBarX, hBarY, barWidth, barHeight, DARKGRAY); // background
+    backend.DrawRectangle(hBarX, hBarY, (int)(barWidth * healthPercent), barHeight, RED); // Health
+    backend.DrawRectangleLines(hBarX, hBarY, barWidth, barHeight, BLACK); // border
+    backend.DrawText(TextFormat("HP: %d / %d", health, maxHealth), hBarX + (barWidth / 4), hBarY + (barHeight / 5), 14, WHITE);
 
 
 
     // Death Screen
     if (isDead) {
-        DrawText("You died! Press R to respawn.", GetScreenWidth() / 2 - 100, GetScreenHeight() / 3, 20, RED);
+        backend.DrawText("You died! Press R to respawn.", backend.GetScreenWidth() / 2 - 100, backend.GetScreenHeight() / 3, 20, RED);
     }
 }
 
 void Player::DebugDrawBounds(const GameCamera& cam) const {
-    DrawRectangleLines(
+    GetDrawBackend().DrawRectangleLines(
         (int)(x - cam.x),
         (int)(y - cam.y),
         (int)width,
@@ -210,11 +191,9 @@ void Player::DebugDrawBounds(const GameCamera& cam) const {
 void Player::FindSpawn(const World& world) {
     int middleX = world.getWidth() / 2;
 
-    for (int y = 0; y < world.getHeight(); y++) {
-        if (world.IsSolidTile(middleX, y)) {
-            spawnX = middleX * tileSize;
-            spawnY = (y - 4) * tileSize;
-            return;
-        }
+    int y = world.GetTopSolidY(middleX);
+    if (y < world.getHeight()) {
+        spawnX = middleX * tileSize;
+        spawnY = (y - 4) * tileSize;
     }
 }
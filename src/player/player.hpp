@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../physics/physicsSystem.hpp"
 #include "../world/world.hpp"
 #include "camera.hpp"
 #include <raylib.h>
@@ -10,6 +11,8 @@ public:
     float spawnY = 0;
     float x = 0;
     float y = 0;
+    float prevX = 0; // position before the latest tick, for drawing between ticks
+    float prevY = 0;
     float width = 22;
     float height = 44;
 
@@ -23,8 +26,6 @@ public:
     float vx = 0;
     float vy = 0;
 
-    float gravity = 1200.0f;
-    float maxFallSpeed = 10000.0f;
     float safeFallSpeed = 1000.0f;
     float fallSpeedDamageScale = 0.2f;
 
@@ -39,20 +40,27 @@ public:
     float timeToIgnoreFallDamage = 0.0f;
     float fallDamageTimer = 0.0f;
 
+    // Key presses are caught every frame and held for the next tick, so a press is
+    // neither lost nor repeated however many ticks a frame runs
+    bool jumpQueued = false;
+    bool respawnQueued = false;
+
+    // Moved by the shared physics step: Update hands the body this tick's position and
+    // velocity, EndTick takes back where it ended up
+    PhysicsSystem::BodyId body = PhysicsSystem::noBody;
+
     void Init(const World& world);
-    void Update(float deltaTime, const World& world);
-    void MoveX(float dx, const World& world);
-    void MoveY(float dy, const World& world);
+    void PollInput();
+    void Update(float deltaTime, const World& world, PhysicsSystem& physics);
+    void EndTick(const PhysicsSystem& physics);
     void IgnoreFallDamage(float deltaTime);
     void StartFallDamageTimer(float time);
     void TakeDamage(int damage);
     void Respawn();
 
     bool IsOnGroundWithTolerance(const World& world, float tolerance = 10.0f) const;
-    bool IsCollidingAt(float px, float py, float w, float h, const World& world) const;
-    bool IsColliding(const World& world) const;
 
-    void Draw(int camDrawX, int camDrawY) const;
+    void Draw(int camDrawX, int camDrawY, float interpolation) const;
     void DrawUI();
     void DebugDrawBounds(const GameCamera& cam) const;
     void FindSpawn(const World& world);
@@ -0,0 +1,90 @@
+#include "drawBackend.hpp"
+#include <algorithm>
+#include <rlgl.h>
+
+static RaylibBackend raylibBackend;
+static DrawBackend* currentBackend = &raylibBackend;
+
+DrawBackend& GetDrawBackend() { return *currentBackend; }
+
+void SetDrawBackend(DrawBackend* backend) {
+    currentBackend = backend ? backend : &raylibBackend;
+}
+
+int RaylibBackend::GetScreenWidth() { return ::GetScreenWidth(); }
+int RaylibBackend::GetScreenHeight() { return ::GetScreenHeight(); }
+
+Texture2D RaylibBackend::LoadTextureFromImage(Image image) { return ::LoadTextureFromImage(image); }
+void RaylibBackend::UnloadTexture(Texture2D texture) { ::UnloadTexture(texture); }
+void RaylibBackend::SetTextureFilter(Texture2D texture, int filter) { ::SetTextureFilter(texture, filter); }
+RenderTexture2D RaylibBackend::LoadRenderTexture(int width, int height) { return ::LoadRenderTexture(width, height); }
+void RaylibBackend::UnloadRenderTexture(RenderTexture2D target) { ::UnloadRenderTexture(target); }
+void RaylibBackend::BeginTextureMode(RenderTexture2D target) { ::BeginTextureMode(target); }
+void RaylibBackend::EndTextureMode() { ::EndTextureMode(); }
+void RaylibBackend::ClearBackground(Color color) { ::ClearBackground(color); }
+
+void RaylibBackend::DrawTexturePro(Texture2D texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    ::DrawTexturePro(texture, src, dest, origin, rotation, tint);
+}
+
+void RaylibBackend::DrawTextureRec(Texture2D texture, Rectangle src, Vector2 position, Color tint) {
+    ::DrawTextureRec(texture, src, position, tint);
+}
+
+// DrawTexturePro without rotation, for many quads under one rlBegin. Runs stay well under
+// raylib's default batch size, so checking the limit once per run keeps them in one batch.
+void RaylibBackend::DrawTextureQuads(Texture2D texture, const TexturedQuad* quads, int count) {
+    if (texture.id == 0) return;
+
+    const int runQuads = 1024;
+    float invWidth = 1.0f / texture.width;
+    float invHeight = 1.0f / texture.height;
+    for (int first = 0; first < count; first += runQuads) {
+        int last = std::min(count, first + runQuads);
+        rlCheckRenderBatchLimit(4 * (last - first));
+        rlSetTexture(texture.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = first; i < last; ++i) {
+            const TexturedQuad& quad = quads[i];
+            float u0 = quad.src.x * invWidth;
+            float v0 = quad.src.y * invHeight;
+            float u1 = (quad.src.x + quad.src.width) * invWidth;
+            float v1 = (quad.src.y + quad.src.height) * invHeight;
+            float x1 = quad.dest.x + quad.dest.width;
+            float y1 = quad.dest.y + quad.dest.height;
+
+            rlColor4ub(quad.tint.r, quad.tint.g, quad.tint.b, quad.tint.a);
+            rlTexCoord2f(u0, v0);
+            rlVertex2f(quad.dest.x, quad.dest.y);
+            rlTexCoord2f(u0, v1);
+            rlVertex2f(quad.dest.x, y1);
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(x1, y1);
+            rlTexCoord2f(u1, v0);
+            rlVertex2f(x1, quad.dest.y);
+        }
+        rlEnd();
+        rlSetTexture(0);
+    }
+}
+
+void RaylibBackend::DrawRectangle(int x, int y, int width, int height, Color color) {
+    ::DrawRectangle(x, y, width, height, color);
+}
+
+void RaylibBackend::DrawRectangleRec(Rectangle rect, Color color) { ::DrawRectangleRec(rect, color); }
+
+void RaylibBackend::DrawRectangleLines(int x, int y, int width, int height, Color color) {
+    ::DrawRectangleLines(x, y, width, height, color);
+}
+
+void RaylibBackend::DrawRectangleLinesEx(Rectangle rect, float thickness, Color color) {
+    ::DrawRectangleLinesEx(rect, thickness, color);
+}
+
+void RaylibBackend::DrawText(const char* text, int x, int y, int fontSize, Color color) {
+    ::DrawText(text, x, y, fontSize, color);
+}
+
+int RaylibBackend::MeasureText(const char* text, int fontSize) { return ::MeasureText(text, fontSize); }
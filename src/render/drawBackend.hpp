@@ -0,0 +1,68 @@
+#pragma once
+#include <raylib.h>
+
+// One quad of a bulk draw; the source must have a positive size
+struct TexturedQuad {
+    Rectangle src;
+    Rectangle dest;
+    Color tint;
+};
+
+// Every draw the game issues goes through the current backend instead of calling raylib
+// directly, so a frame can be recorded and measured without a window. The default is
+// the raylib backend; see RecordingBackend for the headless one.
+class DrawBackend {
+public:
+    virtual ~DrawBackend() = default;
+
+    virtual int GetScreenWidth() = 0;
+    virtual int GetScreenHeight() = 0;
+
+    virtual Texture2D LoadTextureFromImage(Image image) = 0;
+    virtual void UnloadTexture(Texture2D texture) = 0;
+    virtual void SetTextureFilter(Texture2D texture, int filter) = 0;
+    virtual RenderTexture2D LoadRenderTexture(int width, int height) = 0;
+    virtual void UnloadRenderTexture(RenderTexture2D target) = 0;
+    virtual void BeginTextureMode(RenderTexture2D target) = 0;
+    virtual void EndTextureMode() = 0;
+    virtual void ClearBackground(Color color) = 0;
+
+    virtual void DrawTexturePro(Texture2D texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation, Color tint) = 0;
+    virtual void DrawTextureRec(Texture2D texture, Rectangle src, Vector2 position, Color tint) = 0;
+    virtual void DrawTextureQuads(Texture2D texture, const TexturedQuad* quads, int count) = 0; // one texture bind
+    virtual void DrawRectangle(int x, int y, int width, int height, Color color) = 0;
+    virtual void DrawRectangleRec(Rectangle rect, Color color) = 0;
+    virtual void DrawRectangleLines(int x, int y, int width, int height, Color color) = 0;
+    virtual void DrawRectangleLinesEx(Rectangle rect, float thickness, Color color) = 0;
+    virtual void DrawText(const char* text, int x, int y, int fontSize, Color color) = 0;
+    virtual int MeasureText(const char* text, int fontSize) = 0;
+};
+
+class RaylibBackend : public DrawBackend {
+public:
+    int GetScreenWidth() override;
+    int GetScreenHeight() override;
+
+    Texture2D LoadTextureFromImage(Image image) override;
+    void UnloadTexture(Texture2D texture) override;
+    void SetTextureFilter(Texture2D texture, int filter) override;
+    RenderTexture2D LoadRenderTexture(int width, int height) override;
+    void UnloadRenderTexture(RenderTexture2D target) override;
+    void BeginTextureMode(RenderTexture2D target) override;
+    void EndTextureMode() override;
+    void ClearBackground(Color color) override;
+
+    void DrawTexturePro(Texture2D texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation, Color tint) override;
+    void DrawTextureRec(Texture2D texture, Rectangle src, Vector2 position, Color tint) override;
+    void DrawTextureQuads(Texture2D texture, const TexturedQuad* quads, int count) override;
+    void DrawRectangle(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleRec(Rectangle rect, Color color) override;
+    void DrawRectangleLines(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleLinesEx(Rectangle rect, float thickness, Color color) override;
+    void DrawText(const char* text, int x, int y, int fontSize, Color color) override;
+    int MeasureText(const char* text, int fontSize) override;
+};
+
+// The backend draws go to; nullptr restores the raylib backend. Not owned.
+DrawBackend& GetDrawBackend();
+void SetDrawBackend(DrawBackend* backend);
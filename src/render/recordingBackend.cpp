@@ -0,0 +1,141 @@
+#include "recordingBackend.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+RecordingBackend::RecordingBackend(int screenWidth, int screenHeight)
+    : screenWidth(screenWidth), screenHeight(screenHeight) {}
+
+void RecordingBackend::BeginFrame() {
+    stats = FrameStats();
+    boundTexture = 0;
+}
+
+const RecordingBackend::FrameStats& RecordingBackend::getFrameStats() const { return stats; }
+
+double RecordingBackend::getOverdraw() const {
+    return stats.screenPixels / ((double)screenWidth * screenHeight);
+}
+
+int RecordingBackend::getLiveTextures() const { return liveTextures; }
+
+int RecordingBackend::GetScreenWidth() { return screenWidth; }
+int RecordingBackend::GetScreenHeight() { return screenHeight; }
+
+Texture2D RecordingBackend::LoadTextureFromImage(Image image) {
+    Texture2D texture{};
+    texture.id = nextTextureId++;
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.mipmaps = 1;
+    texture.format = image.format;
+    ++liveTextures;
+    return texture;
+}
+
+void RecordingBackend::UnloadTexture(Texture2D texture) {
+    if (texture.id != 0) --liveTextures;
+}
+
+void RecordingBackend::SetTextureFilter(Texture2D, int) {}
+
+RenderTexture2D RecordingBackend::LoadRenderTexture(int width, int height) {
+    RenderTexture2D target{};
+    target.id = nextTextureId++;
+    target.texture.id = nextTextureId++;
+    target.texture.width = width;
+    target.texture.height = height;
+    target.texture.mipmaps = 1;
+    ++liveTextures;
+    return target;
+}
+
+void RecordingBackend::UnloadRenderTexture(RenderTexture2D target) {
+    if (target.id != 0) --liveTextures;
+}
+
+// Switching targets flushes raylib's batch, so the next draw binds again
+void RecordingBackend::BeginTextureMode(RenderTexture2D) {
+    inTextureMode = true;
+    boundTexture = 0;
+    ++stats.targetSwitches;
+}
+
+void RecordingBackend::EndTextureMode() {
+    inTextureMode = false;
+    boundTexture = 0;
+    ++stats.targetSwitches;
+}
+
+void RecordingBackend::ClearBackground(Color) {}
+
+void RecordingBackend::m_Draw(unsigned int texture, int quads) {
+    ++stats.drawCalls;
+    stats.quads += quads;
+    if (texture != boundTexture) {
+        boundTexture = texture;
+        ++stats.textureBinds;
+    }
+}
+
+// Only draws to the screen count towards overdraw
+void RecordingBackend::m_Cover(Rectangle area) {
+    if (inTextureMode) return;
+
+    float x0 = std::max(0.0f, std::min(area.x, area.x + area.width));
+    float y0 = std::max(0.0f, std::min(area.y, area.y + area.height));
+    float x1 = std::min((float)screenWidth, std::max(area.x, area.x + area.width));
+    float y1 = std::min((float)screenHeight, std::max(area.y, area.y + area.height));
+    if (x1 > x0 && y1 > y0) stats.screenPixels += (double)(x1 - x0) * (y1 - y0);
+}
+
+void RecordingBackend::DrawTexturePro(Texture2D texture, Rectangle, Rectangle dest, Vector2 origin, float, Color) {
+    m_Draw(texture.id, 1);
+    m_Cover({dest.x - origin.x, dest.y - origin.y, dest.width, dest.height});
+}
+
+void RecordingBackend::DrawTextureRec(Texture2D texture, Rectangle src, Vector2 position, Color) {
+    m_Draw(texture.id, 1);
+    m_Cover({position.x, position.y, std::fabs(src.width), std::fabs(src.height)});
+}
+
+void RecordingBackend::DrawTextureQuads(Texture2D texture, const TexturedQuad* quads, int count) {
+    m_Draw(texture.id, count);
+    for (int i = 0; i < count; ++i) m_Cover(quads[i].dest);
+}
+
+void RecordingBackend::DrawRectangle(int x, int y, int width, int height, Color color) {
+    DrawRectangleRec({(float)x, (float)y, (float)width, (float)height}, color);
+}
+
+void RecordingBackend::DrawRectangleRec(Rectangle rect, Color) {
+    m_Draw(shapesTexture, 1);
+    m_Cover(rect);
+}
+
+void RecordingBackend::DrawRectangleLines(int x, int y, int width, int height, Color color) {
+    DrawRectangleLinesEx({(float)x, (float)y, (float)width, (float)height}, 1.0f, color);
+}
+
+// An outline is four thin quads along the edges
+void RecordingBackend::DrawRectangleLinesEx(Rectangle rect, float thickness, Color) {
+    m_Draw(shapesTexture, 4);
+    m_Cover({rect.x, rect.y, rect.width, thickness});
+    m_Cover({rect.x, rect.y + rect.height - thickness, rect.width, thickness});
+    m_Cover({rect.x, rect.y + thickness, thickness, rect.height - 2 * thickness});
+    m_Cover({rect.x + rect.width - thickness, rect.y + thickness, thickness, rect.height - 2 * thickness});
+}
+
+void RecordingBackend::DrawText(const char* text, int x, int y, int fontSize, Color) {
+    int glyphs = 0;
+    for (const char* c = text; *c; ++c) {
+        if (*c != ' ' && *c != '\n') ++glyphs;
+    }
+    m_Draw(fontTexture, glyphs);
+    m_Cover({(float)x, (float)y, (float)MeasureText(text, fontSize), (float)fontSize});
+}
+
+// raylib's default font advances about 6 px per 10 px of size
+int RecordingBackend::MeasureText(const char* text, int fontSize) {
+    return (int)strlen(text) * fontSize * 6 / 10;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "drawBackend.hpp"
+
+// Headless backend: nothing reaches the GPU, every call is counted instead. Textures get
+// fake ids so binds can be tracked. A texture bind is counted whenever a draw samples a
+// different texture than the draw before it, which is where raylib has to break its batch.
+class RecordingBackend : public DrawBackend {
+public:
+    struct FrameStats {
+        int drawCalls = 0;      // draw functions called
+        int textureBinds = 0;
+        int targetSwitches = 0; // BeginTextureMode and EndTextureMode
+        int quads = 0;          // rectangle outlines count four, text one per glyph
+        double screenPixels = 0.0; // pixel area drawn to the screen, clipped to it
+    };
+
+    RecordingBackend(int screenWidth, int screenHeight);
+
+    void BeginFrame(); // resets the frame stats
+    const FrameStats& getFrameStats() const;
+    double getOverdraw() const; // screen pixels drawn this frame per pixel of screen
+    int getLiveTextures() const; // loaded and not yet unloaded, render targets included
+
+    int GetScreenWidth() override;
+    int GetScreenHeight() override;
+
+    Texture2D LoadTextureFromImage(Image image) override;
+    void UnloadTexture(Texture2D texture) override;
+    void SetTextureFilter(Texture2D texture, int filter) override;
+    RenderTexture2D LoadRenderTexture(int width, int height) override;
+    void UnloadRenderTexture(RenderTexture2D target) override;
+    void BeginTextureMode(RenderTexture2D target) override;
+    void EndTextureMode() override;
+    void ClearBackground(Color color) override;
+
+    void DrawTexturePro(Texture2D texture, Rectangle src, Rectangle dest, Vector2 origin, float rotation, Color tint) override;
+    void DrawTextureRec(Texture2D texture, Rectangle src, Vector2 position, Color tint) override;
+    void DrawTextureQuads(Texture2D texture, const TexturedQuad* quads, int count) override;
+    void DrawRectangle(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleRec(Rectangle rect, Color color) override;
+    void DrawRectangleLines(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleLinesEx(Rectangle rect, float thickness, Color color) override;
+    void DrawText(const char* text, int x, int y, int fontSize, Color color) override;
+    int MeasureText(const char* text, int fontSize) override;
+
+private:
+    // Stand-ins for the textures raylib draws shapes and the default font with
+    static constexpr unsigned int shapesTexture = 0xFFFF0001u;
+    static constexpr unsigned int fontTexture = 0xFFFF0002u;
+
+    void m_Draw(unsigned int texture, int quads);
+    void m_Cover(Rectangle area);
+
+    int screenWidth;
+    int screenHeight;
+    bool inTextureMode = false;
+    unsigned int boundTexture = 0;
+    unsigned int nextTextureId = 1;
+    int liveTextures = 0;
+    FrameStats stats;
+};
@@ -6,3 +6,4 @@ int windowWidth = 1280;
 int windowHeight = 720;
 int gridSize = 32; // creates 25 x 25 grid with 800 x 800 screen
 int tileSize = 18; // original 25
+bool streamWorld = true;
@@ -4,3 +4,4 @@ extern int windowWidth;
 extern int windowHeight;
 extern int gridSize; // creates 25 x 25 grid with 800 x 800 screen
 extern int tileSize; // original 25
+extern bool streamWorld; // endless world streamed around the player
@@ -0,0 +1,42 @@
+#include "hash.hpp"
+#include <cstring>
+
+static constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+
+static uint64_t Rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Murmur3 finaliser, spreads every input bit over the whole result
+static uint64_t Mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed ^ (size * prime1);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8); // little-endian hosts only
+        hash = Rotl(hash ^ (word * prime2), 31) * prime1;
+    }
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < size; ++i, shift += 8) {
+        tail |= static_cast<uint64_t>(bytes[i]) << shift;
+    }
+    hash = Rotl(hash ^ (tail * prime2), 31) * prime1;
+
+    return Mix(hash);
+}
+
+uint64_t HashCombine(uint64_t hash, uint64_t value) {
+    return Mix(Rotl(hash, 27) * prime1 ^ value);
+}
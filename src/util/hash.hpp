@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Fast non-cryptographic 64-bit hashing for checking that generated output is unchanged.
+// Results only depend on the bytes, so they can be pinned across runs and machines.
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+uint64_t HashCombine(uint64_t hash, uint64_t value);
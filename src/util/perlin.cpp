@@ -22,8 +22,13 @@ PerlinNoise::PerlinNoise(unsigned int seed) {
     p.resize(256);
     std::iota(p.begin(), p.end(), 0);
 
-    std::default_random_engine engine(seed);
-    std::shuffle(p.begin(), p.end(), engine);
+    // Fisher-Yates with raw mt19937 output; std::shuffle's algorithm is up to the
+    // standard library, which would make the same seed build different worlds.
+    std::mt19937 engine(seed);
+    for (int i = 255; i > 0; --i) {
+        int j = engine() % (i + 1);
+        std::swap(p[i], p[j]);
+    }
 
     p.insert(p.end(), p.begin(), p.end());
 }
@@ -15,7 +15,21 @@ private:
     static double grad(int hash, double x, double y);
 
 public:
+    enum Kernel { KERNEL_SCALAR, KERNEL_SSE41, KERNEL_AVX2 };
+
     explicit PerlinNoise(unsigned int seed = 2023);
     double noise(double x, double y) const;
+
+    // Batched noise in float. Results stay within 1e-4 of noise() at the same point and
+    // are bit-identical across kernels, so a seed builds the same world on every CPU.
+    void NoiseBatch(const float* xs, const float* ys, float* out, int count) const;
+    // Samples (x0 + i * step, y) for i in [0, count). Coordinates are wrapped into the
+    // 256 period in double first so large world positions keep float precision.
+    void NoiseRow(double x0, double step, double y, float* out, int count) const;
+
+    // Picks the widest kernel the CPU supports unless one is forced (e.g. by a benchmark);
+    // forcing an unsupported kernel falls back to the best available one
+    static void SetKernel(Kernel kernel);
+    static Kernel GetKernel();
 };
 
@@ -0,0 +1,251 @@
+// Float Perlin kernels for filling whole rows of samples at once. The scalar, SSE4.1 and
+// AVX2 paths run the same operations in the same order, so they agree bit for bit; FMA
+// contraction is disabled for this file because it would round differently per path.
+#pragma GCC optimize("fp-contract=off")
+
+#include "perlin.hpp"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PERLIN_X86 1
+#include <immintrin.h>
+#endif
+
+static inline float FadeF(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static inline float LerpF(float a, float b, float t) {
+    return a + t * (b - a);
+}
+
+static inline float GradF(int hash, float x, float y) {
+    int h = hash & 7;
+    float u = h < 4 ? x : y;
+    float v = h < 4 ? y : x;
+    return ((h & 1) ? -u : u) + ((h & 2) ? -(v + v) : (v + v));
+}
+
+static inline float NoiseF(const int* p, float x, float y) {
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    int X = (int)fx & 255;
+    int Y = (int)fy & 255;
+
+    float xf = x - fx;
+    float yf = y - fy;
+
+    float u = FadeF(xf);
+    float v = FadeF(yf);
+
+    int a = p[X] + Y;
+    int b = p[X + 1] + Y;
+
+    float x1 = LerpF(GradF(p[a], xf, yf), GradF(p[b], xf - 1.0f, yf), u);
+    float x2 = LerpF(GradF(p[a + 1], xf, yf - 1.0f), GradF(p[b + 1], xf - 1.0f, yf - 1.0f), u);
+
+    return LerpF(x1, x2, v);
+}
+
+static void NoiseScalar(const int* p, const float* xs, const float* ys, float* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = NoiseF(p, xs[i], ys[i]);
+    }
+}
+
+#ifdef PERLIN_X86
+
+__attribute__((target("sse4.1")))
+static inline __m128 FadeSse(__m128 t) {
+    __m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+    __m128 inner = _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+    inner = _mm_add_ps(_mm_mul_ps(t, inner), _mm_set1_ps(10.0f));
+    return _mm_mul_ps(t3, inner);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128 LerpSse(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128 GradSse(__m128i hash, __m128 x, __m128 y) {
+    __m128i h = _mm_and_si128(hash, _mm_set1_epi32(7));
+    __m128 low = _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4)));
+    __m128 u = _mm_blendv_ps(y, x, low);
+    __m128 v = _mm_blendv_ps(x, y, low);
+    v = _mm_add_ps(v, v);
+    // Bits 0 and 1 of the hash flip the signs of u and 2v
+    __m128 signU = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(1)), 31));
+    __m128 signV = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(2)), 30));
+    return _mm_add_ps(_mm_xor_ps(u, signU), _mm_xor_ps(v, signV));
+}
+
+// SSE4.1 has no gather, so the permutation lookups stay scalar per lane
+__attribute__((target("sse4.1")))
+static void NoiseSse41(const int* p, const float* xs, const float* ys, float* out, int count) {
+    const __m128i wrap = _mm_set1_epi32(255);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 fx = _mm_floor_ps(x);
+        __m128 fy = _mm_floor_ps(y);
+
+        alignas(16) int X[4], Y[4];
+        _mm_store_si128((__m128i*)X, _mm_and_si128(_mm_cvttps_epi32(fx), wrap));
+        _mm_store_si128((__m128i*)Y, _mm_and_si128(_mm_cvttps_epi32(fy), wrap));
+
+        alignas(16) int aa[4], ab[4], ba[4], bb[4];
+        for (int lane = 0; lane < 4; ++lane) {
+            int a = p[X[lane]] + Y[lane];
+            int b = p[X[lane] + 1] + Y[lane];
+            aa[lane] = p[a];
+            ab[lane] = p[a + 1];
+            ba[lane] = p[b];
+            bb[lane] = p[b + 1];
+        }
+
+        __m128 xf = _mm_sub_ps(x, fx);
+        __m128 yf = _mm_sub_ps(y, fy);
+        __m128 xf1 = _mm_sub_ps(xf, one);
+        __m128 yf1 = _mm_sub_ps(yf, one);
+        __m128 u = FadeSse(xf);
+        __m128 v = FadeSse(yf);
+
+        __m128 x1 = LerpSse(GradSse(_mm_load_si128((const __m128i*)aa), xf, yf),
+                            GradSse(_mm_load_si128((const __m128i*)ba), xf1, yf), u);
+        __m128 x2 = LerpSse(GradSse(_mm_load_si128((const __m128i*)ab), xf, yf1),
+                            GradSse(_mm_load_si128((const __m128i*)bb), xf1, yf1), u);
+        _mm_storeu_ps(out + i, LerpSse(x1, x2, v));
+    }
+    NoiseScalar(p, xs + i, ys + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256 FadeAvx2(__m256 t) {
+    __m256 t3 = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+    __m256 inner = _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f));
+    inner = _mm256_add_ps(_mm256_mul_ps(t, inner), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(t3, inner);
+}
+
+__attribute__((target("avx2")))
+static inline __m256 LerpAvx2(__m256 a, __m256 b, __m256 t) {
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+__attribute__((target("avx2")))
+static inline __m256 GradAvx2(__m256i hash, __m256 x, __m256 y) {
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(7));
+    __m256 low = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+    __m256 u = _mm256_blendv_ps(y, x, low);
+    __m256 v = _mm256_blendv_ps(x, y, low);
+    v = _mm256_add_ps(v, v);
+    __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+    return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+}
+
+__attribute__((target("avx2")))
+static void NoiseAvx2(const int* p, const float* xs, const float* ys, float* out, int count) {
+    const __m256i wrap = _mm256_set1_epi32(255);
+    const __m256i next = _mm256_set1_epi32(1);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x = _mm256_loadu_ps(xs + i);
+        __m256 y = _mm256_loadu_ps(ys + i);
+        __m256 fx = _mm256_floor_ps(x);
+        __m256 fy = _mm256_floor_ps(y);
+        __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(fx), wrap);
+        __m256i Y = _mm256_and_si256(_mm256_cvttps_epi32(fy), wrap);
+
+        __m256i a = _mm256_add_epi32(_mm256_i32gather_epi32(p, X, 4), Y);
+        __m256i b = _mm256_add_epi32(_mm256_i32gather_epi32(p, _mm256_add_epi32(X, next), 4), Y);
+        __m256i aa = _mm256_i32gather_epi32(p, a, 4);
+        __m256i ab = _mm256_i32gather_epi32(p, _mm256_add_epi32(a, next), 4);
+        __m256i ba = _mm256_i32gather_epi32(p, b, 4);
+        __m256i bb = _mm256_i32gather_epi32(p, _mm256_add_epi32(b, next), 4);
+
+        __m256 xf = _mm256_sub_ps(x, fx);
+        __m256 yf = _mm256_sub_ps(y, fy);
+        __m256 xf1 = _mm256_sub_ps(xf, one);
+        __m256 yf1 = _mm256_sub_ps(yf, one);
+        __m256 u = FadeAvx2(xf);
+        __m256 v = FadeAvx2(yf);
+
+        __m256 x1 = LerpAvx2(GradAvx2(aa, xf, yf), GradAvx2(ba, xf1, yf), u);
+        __m256 x2 = LerpAvx2(GradAvx2(ab, xf, yf1), GradAvx2(bb, xf1, yf1), u);
+        _mm256_storeu_ps(out + i, LerpAvx2(x1, x2, v));
+    }
+    NoiseScalar(p, xs + i, ys + i, out + i, count - i);
+}
+
+#endif
+
+static PerlinNoise::Kernel BestKernel() {
+    static const PerlinNoise::Kernel best = [] {
+#ifdef PERLIN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return PerlinNoise::KERNEL_AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return PerlinNoise::KERNEL_SSE41;
+#endif
+        return PerlinNoise::KERNEL_SCALAR;
+    }();
+    return best;
+}
+
+static std::atomic<int> forcedKernel{-1};
+
+void PerlinNoise::SetKernel(Kernel kernel) {
+    forcedKernel = std::min(kernel, BestKernel());
+}
+
+PerlinNoise::Kernel PerlinNoise::GetKernel() {
+    int forced = forcedKernel;
+    return forced < 0 ? BestKernel() : static_cast<Kernel>(forced);
+}
+
+void PerlinNoise::NoiseBatch(const float* xs, const float* ys, float* out, int count) const {
+    switch (GetKernel()) {
+#ifdef PERLIN_X86
+    case KERNEL_AVX2:
+        NoiseAvx2(p.data(), xs, ys, out, count);
+        break;
+    case KERNEL_SSE41:
+        NoiseSse41(p.data(), xs, ys, out, count);
+        break;
+#endif
+    default:
+        NoiseScalar(p.data(), xs, ys, out, count);
+        break;
+    }
+}
+
+// The permutation repeats every 256 units on both axes. Scaling by a power of two and
+// dropping the integer part are exact, and truncation is much cheaper than floor().
+static float WrapPeriod(double v) {
+    double t = v * (1.0 / 256.0);
+    t -= static_cast<double>(static_cast<long long>(t));
+    if (t < 0.0) t += 1.0;
+    return static_cast<float>(t * 256.0);
+}
+
+void PerlinNoise::NoiseRow(double x0, double step, double y, float* out, int count) const {
+    constexpr int block = 256;
+    float xs[block];
+    float ys[block];
+    std::fill_n(ys, block, WrapPeriod(y));
+
+    for (int start = 0; start < count; start += block) {
+        int n = std::min(block, count - start);
+        for (int i = 0; i < n; ++i) {
+            xs[i] = WrapPeriod(x0 + (start + i) * step);
+        }
+        NoiseBatch(xs, ys, out + start, n);
+    }
+}
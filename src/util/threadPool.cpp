@@ -0,0 +1,70 @@
+#include "threadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::m_WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::getThreadCount() const {
+    return workers.size() + 1;
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& task) {
+    if (workers.empty() || count <= 1) {
+        for (int i = 0; i < count; ++i) task(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        taskCount = count;
+        nextIndex = 0;
+        busyWorkers = workers.size();
+        batch++;
+    }
+    wake.notify_all();
+
+    m_RunTasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return busyWorkers == 0; });
+    this->task = nullptr;
+}
+
+void ThreadPool::m_RunTasks() {
+    for (int i = nextIndex.fetch_add(1); i < taskCount; i = nextIndex.fetch_add(1)) {
+        (*task)(i);
+    }
+}
+
+void ThreadPool::m_WorkerLoop() {
+    uint64_t seenBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || batch != seenBatch; });
+            if (stopping) return;
+            seenBatch = batch;
+        }
+
+        m_RunTasks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) done.notify_one();
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for splitting index ranges. The calling thread works
+// too, so a pool of N threads starts N - 1 workers. ParallelFor is not reentrant.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int threadCount = 0); // 0 = one per hardware thread
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs task(i) for every i in [0, count) and returns once all of them finished
+    void ParallelFor(int count, const std::function<void(int)>& task);
+    unsigned int getThreadCount() const;
+
+private:
+    void m_WorkerLoop();
+    void m_RunTasks();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(int)>* task = nullptr;
+    int taskCount = 0;
+    std::atomic<int> nextIndex{0};
+    size_t busyWorkers = 0;
+    uint64_t batch = 0;
+    bool stopping = false;
+};
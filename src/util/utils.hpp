@@ -10,3 +10,11 @@ unsigned int generateRandomSeed();
 double findDistance(int x1, int y1, int x2, int y2);
 Vector2 diffVector(int x1, int y1, int x2, int y2);
 
+// Sine to within 0.002 for any x a float holds to a few decimals. Branch free and inline, so loops over it vectorize
+// where sinf would not.
+inline float fastSin(float x) {
+    float turns = x * 0.15915494f; // 1 / 2pi
+    x -= 6.2831853f * (float)(int)(turns + std::copysign(0.5f, turns)); // now in [-pi, pi]
+    float y = 1.2732395f * x - 0.40528473f * x * std::fabs(x); // 4/pi, 4/pi^2
+    return 0.225f * (y * std::fabs(y) - y) + y;
+}
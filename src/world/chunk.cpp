@@ -0,0 +1,52 @@
+#include "chunk.hpp"
+#include <algorithm>
+
+bool CompressedChunk::Compress(const uint8_t* tiles, CompressedChunk& out) {
+    out.paletteSize = 0;
+    out.runs.clear();
+
+    uint8_t lookup[256];
+    std::fill(std::begin(lookup), std::end(lookup), 0xFF);
+    for (int i = 0; i < chunkArea; ++i) {
+        uint8_t tile = tiles[i];
+        if (lookup[tile] != 0xFF) continue;
+        if (out.paletteSize == maxPalette) return false;
+        lookup[tile] = out.paletteSize;
+        out.palette[out.paletteSize++] = tile;
+    }
+
+    if (out.paletteSize == 1) {
+        out.rowStart.fill(0);
+        return true;
+    }
+
+    for (int y = 0; y < chunkSize; ++y) {
+        out.rowStart[y] = out.runs.size();
+        const uint8_t* row = tiles + y * chunkSize;
+        int x = 0;
+        while (x < chunkSize) {
+            int start = x;
+            while (x < chunkSize && row[x] == row[start]) ++x;
+            out.runs.push_back((lookup[row[start]] << chunkShift) | (x - start - 1));
+        }
+    }
+    out.rowStart[chunkSize] = out.runs.size();
+    out.runs.shrink_to_fit();
+    return true;
+}
+
+void CompressedChunk::Decompress(uint8_t* tiles) const {
+    if (paletteSize == 1) {
+        std::fill_n(tiles, chunkArea, palette[0]);
+        return;
+    }
+
+    uint8_t* out = tiles;
+    for (uint8_t run : runs) {
+        out = std::fill_n(out, (run & chunkMask) + 1, palette[run >> chunkShift]);
+    }
+}
+
+size_t CompressedChunk::ByteSize() const {
+    return sizeof(CompressedChunk) + runs.capacity();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// World tiles are stored in square chunks so edits can be tracked per region.
+constexpr int chunkShift = 5;
+constexpr int chunkSize = 1 << chunkShift; // 32 x 32 tiles
+constexpr int chunkMask = chunkSize - 1;
+constexpr int chunkArea = chunkSize * chunkSize;
+
+// Cold chunk representation: a palette of the tile ids the chunk uses and, per row,
+// runs packed into one byte each (palette index in the top 3 bits, length - 1 below).
+// A single-entry palette means the whole chunk is that tile and has no runs. Light
+// levels are packed the same way.
+struct CompressedChunk {
+    static constexpr int maxPalette = 8;
+    static_assert(chunkShift == 5, "runs pack a 3 bit palette index and a 5 bit length");
+
+    uint8_t paletteSize = 0;
+    uint8_t palette[maxPalette];
+    std::array<uint16_t, chunkSize + 1> rowStart{}; // first run of each row, plus end
+    std::vector<uint8_t> runs;
+
+    // Fails when the chunk uses more than maxPalette tile types
+    static bool Compress(const uint8_t* tiles, CompressedChunk& out);
+    void Decompress(uint8_t* tiles) const;
+    size_t ByteSize() const;
+    int TileAt(int localX, int localY) const;
+};
+
+struct Chunk {
+    uint8_t* tiles = nullptr;           // chunkArea tile ids, see World::TileType; null while compressed
+    std::unique_ptr<uint8_t[]> storage; // owns tiles unless they point into a mapped save
+    std::unique_ptr<CompressedChunk> compressed;
+    uint32_t version = 0; // bumped on every edit so caches and savers can skip unchanged chunks
+    bool edited = false;  // changed since it was generated
+
+    uint32_t seenVersion = 0; // version at the last compression sweep
+    uint16_t idleSweeps = 0;  // sweeps in a row without an edit
+
+    // Occupancy per tile column: bit y is set when the tile in row y is solid / not air.
+    // Stays valid while the tiles are compressed, see World::AnySolid.
+    static_assert(chunkSize == 32, "a column of a chunk is one 32 bit mask");
+    uint32_t solidColumns[chunkSize] = {};
+    uint32_t nonAirColumns[chunkSize] = {};
+
+    // Sky light in the high nibble and block light in the low one, see World::GetSkyLight.
+    // Stored the way the tiles are: expanded, compressed with them when the chunk goes
+    // cold, or, when every tile has the same level (open sky, unlit rock), as that level.
+    uint8_t* light = nullptr; // chunkArea levels; null while uniform or compressed
+    std::unique_ptr<uint8_t[]> lightStorage; // owns light unless it points into a mapped save
+    std::unique_ptr<CompressedChunk> compressedLight;
+    uint8_t uniformLight = 0; // every level, while light and compressedLight are both null
+    uint32_t lightVersion = 0; // like version, but bumped when light levels change
+};
+
+inline int CompressedChunk::TileAt(int localX, int localY) const {
+    if (paletteSize == 1) return palette[0];
+
+    int x = 0;
+    for (int i = rowStart[localY]; ; ++i) {
+        uint8_t run = runs[i];
+        x += (run & chunkMask) + 1;
+        if (localX < x) return palette[run >> chunkShift];
+    }
+}
@@ -0,0 +1,75 @@
+#include "chunkRenderCache.hpp"
+#include "chunk.hpp"
+#include "world.hpp" // for tileSize
+
+void ChunkRenderCache::BeginFrame() {
+    ++frame;
+    stats = FrameStats();
+}
+
+// Reuses the entry drawn longest ago when the cache is full, so its texture is never reallocated
+ChunkRenderCache::Entry* ChunkRenderCache::m_Acquire(int64_t key) {
+    auto found = entries.find(key);
+    if (found != entries.end()) return &found->second;
+
+    Entry entry;
+    if ((int)entries.size() >= maxEntries) {
+        auto oldest = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.lastFrame == frame) continue; // on screen this frame
+            if (oldest == entries.end() || it->second.lastFrame < oldest->second.lastFrame) oldest = it;
+        }
+        if (oldest == entries.end()) return nullptr;
+        entry.target = oldest->second.target;
+        entries.erase(oldest);
+    } else {
+        DrawBackend& backend = GetDrawBackend();
+        int pixels = chunkSize * tileSize;
+        entry.target = backend.LoadRenderTexture(pixels, pixels);
+        backend.SetTextureFilter(entry.target.texture, TEXTURE_FILTER_POINT);
+    }
+    return &entries.emplace(key, entry).first->second;
+}
+
+ChunkRenderCache::BakeResult ChunkRenderCache::BeginBake(int64_t key, uint32_t version) {
+    Entry* entry = m_Acquire(key);
+    if (!entry) {
+        ++stats.chunksUncached;
+        return BAKE_UNCACHED;
+    }
+    entry->lastFrame = frame;
+    if (entry->baked && entry->version == version) return BAKE_CURRENT;
+
+    entry->version = version;
+    entry->baked = true;
+    ++stats.chunksBaked;
+    GetDrawBackend().BeginTextureMode(entry->target);
+    GetDrawBackend().ClearBackground(BLANK);
+    return BAKE_STARTED;
+}
+
+void ChunkRenderCache::EndBake() {
+    GetDrawBackend().EndTextureMode();
+}
+
+void ChunkRenderCache::Draw(int64_t key, int screenX, int screenY) {
+    auto found = entries.find(key);
+    if (found == entries.end()) return;
+
+    ++stats.chunksDrawn;
+
+    // Render textures are stored bottom up, hence the negative source height
+    const Texture2D& texture = found->second.target.texture;
+    Rectangle src = {0.0f, 0.0f, (float)texture.width, -(float)texture.height};
+    GetDrawBackend().DrawTextureRec(texture, src, {(float)screenX, (float)screenY}, WHITE);
+}
+
+void ChunkRenderCache::Unload() {
+    for (auto& [key, entry] : entries) {
+        if (entry.target.id != 0) GetDrawBackend().UnloadRenderTexture(entry.target);
+    }
+    entries.clear();
+}
+
+const ChunkRenderCache::FrameStats& ChunkRenderCache::getFrameStats() const { return stats; }
+int ChunkRenderCache::getCachedChunks() const { return entries.size(); }
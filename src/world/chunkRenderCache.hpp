@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <raylib.h>
+#include "../render/drawBackend.hpp"
+
+// Keeps the static tiles of each visible chunk baked into a render texture, so a frame
+// draws one quad per chunk instead of one per tile. An entry is rebaked only when its
+// chunk version changes; the least recently drawn entry is recycled once the cache is full.
+// The cache never grows past maxEntries: when every entry is already on screen this frame,
+// the chunk is left to the caller to draw tile by tile.
+//
+// Usage per chunk: BeginBake(key, version), then for BAKE_STARTED draw its tiles and EndBake(),
+// and for either of those Draw(key, ...). For BAKE_UNCACHED draw its tiles straight to the
+// screen. Keys must stay stable across streaming shifts (absolute chunk ids).
+// Textures come from the current DrawBackend.
+class ChunkRenderCache {
+public:
+    enum BakeResult {
+        BAKE_CURRENT,  // the baked texture is up to date
+        BAKE_STARTED,  // the chunk's render target is open for its tiles
+        BAKE_UNCACHED, // no texture to spare this frame
+    };
+
+    struct FrameStats {
+        int chunksDrawn = 0;
+        int chunksBaked = 0;
+        int chunksUncached = 0;
+    };
+
+    static constexpr int maxEntries = 48; // about four screens of chunks
+
+    void BeginFrame(); // resets the frame stats
+    BakeResult BeginBake(int64_t key, uint32_t version);
+    void EndBake();
+    void Draw(int64_t key, int screenX, int screenY);
+    void Unload(); // frees every texture, needs the backend still up
+
+    const FrameStats& getFrameStats() const;
+    int getCachedChunks() const;
+
+private:
+    struct Entry {
+        RenderTexture2D target{};
+        uint32_t version = 0;
+        uint64_t lastFrame = 0;
+        bool baked = false;
+    };
+
+    Entry* m_Acquire(int64_t key); // nullptr when full of entries drawn this frame
+
+    std::unordered_map<int64_t, Entry> entries;
+    uint64_t frame = 0;
+    FrameStats stats;
+};
@@ -0,0 +1,144 @@
+#include "generationPipeline.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "world.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void GenerationPipeline::AddPass(const GenerationPass& pass) {
+    uint32_t touched = pass.reads | pass.writes;
+    int stage = 0;
+    for (size_t i = 0; i < passes.size(); ++i) {
+        if ((passes[i].reads | passes[i].writes) & touched) {
+            stage = std::max(stage, stats[i].stage + 1);
+        }
+    }
+
+    passes.push_back(pass);
+    stats.push_back({ pass.name, stage });
+    stageCount = std::max(stageCount, stage + 1);
+}
+
+// Columns are snapshotted between stages; every tile that changed is credited to the pass
+// of the stage that declares its new type, which is unique because stage passes share no types
+void GenerationPipeline::m_CountChanges(World& world, const std::vector<int>& stagePasses, int chunkX,
+                                        std::vector<uint8_t>& before) {
+    std::vector<uint8_t> after(before.size());
+    world.CopyColumn(chunkX, after.data());
+
+    int owner[256];
+    std::fill_n(owner, 256, -1);
+    for (int p : stagePasses) {
+        for (int tile = 0; tile < 32; ++tile) {
+            if (passes[p].writes & (1u << tile)) owner[tile] = p;
+        }
+    }
+
+    std::vector<uint64_t> changed(passes.size(), 0);
+    uint64_t undeclared = 0;
+    for (size_t i = 0; i < after.size(); ++i) {
+        if (after[i] == before[i]) continue;
+        int p = owner[after[i]];
+        if (p < 0 || !(passes[p].reads & (1u << before[i]))) {
+            ++undeclared;
+            p = stagePasses[0];
+        }
+        ++changed[p];
+    }
+    before.swap(after);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (int p : stagePasses) stats[p].tilesChanged += changed[p];
+    if (undeclared > 0 && !warnedUndeclared) {
+        warnedUndeclared = true;
+        std::cout << "Generation stage " << stats[stagePasses[0]].stage << " changed " << undeclared
+                  << " tiles its passes don't declare" << std::endl;
+    }
+}
+
+void GenerationPipeline::m_RunPass(World& world, int pass, int chunkX) {
+    int x0 = chunkX * chunkSize;
+    int x1 = std::min(x0 + chunkSize, world.getWidth());
+
+    auto start = Clock::now();
+    passes[pass].run(world, x0, x1);
+    double ms = MsSince(start);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats[pass].ms += ms;
+    lastPass = pass;
+    ++completedRuns;
+}
+
+std::vector<int> GenerationPipeline::m_StagePasses(int stage) const {
+    std::vector<int> stagePasses;
+    for (size_t p = 0; p < passes.size(); ++p) {
+        if (stats[p].stage == stage) stagePasses.push_back(p);
+    }
+    return stagePasses;
+}
+
+void GenerationPipeline::Run(World& world, ThreadPool& pool, const std::vector<int>& columns) {
+    auto start = Clock::now();
+    size_t columnBytes = (size_t)world.getChunksY() * chunkArea;
+    int columnCount = columns.size();
+
+    std::vector<std::vector<uint8_t>> snapshots(columnCount);
+    pool.ParallelFor(columnCount, [&](int i) {
+        snapshots[i].resize(columnBytes);
+        world.CopyColumn(columns[i], snapshots[i].data());
+    });
+
+    for (int stage = 0; stage < stageCount; ++stage) {
+        std::vector<int> stagePasses = m_StagePasses(stage);
+        // One task per column, so no two passes ever write the same chunk at once
+        pool.ParallelFor(columnCount, [&](int i) {
+            for (int pass : stagePasses) m_RunPass(world, pass, columns[i]);
+            m_CountChanges(world, stagePasses, columns[i], snapshots[i]);
+        });
+    }
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    wallMs += MsSince(start);
+}
+
+void GenerationPipeline::RunColumn(World& world, int chunkX) {
+    std::vector<uint8_t> snapshot((size_t)world.getChunksY() * chunkArea);
+    world.CopyColumn(chunkX, snapshot.data());
+
+    for (int stage = 0; stage < stageCount; ++stage) {
+        std::vector<int> stagePasses = m_StagePasses(stage);
+        for (int pass : stagePasses) {
+            m_RunPass(world, pass, chunkX);
+        }
+        m_CountChanges(world, stagePasses, chunkX, snapshot);
+    }
+}
+
+const std::vector<GenerationPass>& GenerationPipeline::getPasses() const { return passes; }
+const std::vector<GenerationPassStats>& GenerationPipeline::getStats() const { return stats; }
+int GenerationPipeline::getStageCount() const { return stageCount; }
+double GenerationPipeline::getWallMs() const { return wallMs; }
+
+void GenerationPipeline::ResetStats() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    for (GenerationPassStats& pass : stats) {
+        pass.ms = 0.0;
+        pass.tilesChanged = 0;
+    }
+    wallMs = 0.0;
+    completedRuns = 0;
+    lastPass = -1;
+}
+
+int GenerationPipeline::getCompletedRuns() const { return completedRuns; }
+
+const char* GenerationPipeline::getLastPassName() const {
+    int pass = lastPass;
+    return pass < 0 ? nullptr : passes[pass].name;
+}
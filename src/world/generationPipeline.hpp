@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class World;
+class ThreadPool;
+
+// One step of terrain generation. A pass fills in the chunk column [x0, x1) of the world
+// and may only look at tiles inside it. reads and writes are bitmasks of World::TileType:
+// reads covers every type the pass inspects or overwrites, writes every type it produces.
+struct GenerationPass {
+    const char* name;
+    uint32_t reads;
+    uint32_t writes;
+    void (*run)(World& world, int x0, int x1);
+};
+
+struct GenerationPassStats {
+    const char* name;
+    int stage;
+    double ms = 0.0;           // summed over columns, so CPU time rather than wall time
+    uint64_t tilesChanged = 0; // tiles whose type this pass changed
+};
+
+// Runs passes over chunk columns. Passes whose tile types don't overlap commute, so each
+// pass is scheduled in the stage after the last earlier pass it touches types of. Columns
+// run concurrently; within a column the passes of a stage run one after another, in the
+// order they were added, and every column finishes a stage before the next one starts.
+class GenerationPipeline {
+public:
+    void AddPass(const GenerationPass& pass);
+
+    // Whole-world generation spread over the pool, stage by stage
+    void Run(World& world, ThreadPool& pool, const std::vector<int>& columns);
+    // One column on the calling thread, e.g. from inside another ParallelFor
+    void RunColumn(World& world, int chunkX);
+
+    const std::vector<GenerationPass>& getPasses() const;
+    const std::vector<GenerationPassStats>& getStats() const; // parallel to getPasses()
+    int getStageCount() const;
+    double getWallMs() const; // wall time of the Run calls since the last reset
+    void ResetStats();
+
+    // Progress since the last reset, safe to read while another thread generates
+    int getCompletedRuns() const;        // (column, pass) runs finished
+    const char* getLastPassName() const; // pass of the latest finished run, nullptr before any
+
+private:
+    void m_RunPass(World& world, int pass, int chunkX);
+    void m_CountChanges(World& world, const std::vector<int>& stagePasses, int chunkX,
+                        std::vector<uint8_t>& before);
+    std::vector<int> m_StagePasses(int stage) const;
+
+    std::vector<GenerationPass> passes;
+    std::vector<GenerationPassStats> stats;
+    int stageCount = 0;
+    double wallMs = 0.0;
+    bool warnedUndeclared = false;
+    std::mutex statsMutex;
+    std::atomic<int> completedRuns{0};
+    std::atomic<int> lastPass{-1};
+};
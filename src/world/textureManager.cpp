@@ -1,83 +1,123 @@
 #include "textureManager.hpp"
 #include "world.hpp" // for texture types
 #include "../game/item.hpp" // for texture types
+#include "../render/drawBackend.hpp"
+#include <algorithm>
 #include <raylib.h>
 
+// Packs the block sprites left to right into one atlas, plus a small white cell for
+// solid rectangles. Each cell gets a one pixel border copied from the sprite's edges.
 void TextureManager::Load() {
-    m_LoadFilterTexture("graphics/blocks/Stone.png", stoneTexture);
-    m_LoadFilterTexture("graphics/blocks/Dirt.png", dirtTexture);
-    m_LoadFilterTexture("graphics/blocks/Dirt_Grass.png", grassTexture);
-    m_LoadFilterTexture("graphics/blocks/Tree_Trunk.png", trunkTexture);
-    m_LoadFilterTexture("graphics/blocks/Tree_Leaves.png", leavesTexture);
+    DrawBackend& backend = GetDrawBackend();
+    static const char* paths[TEXTURE_COUNT] = {
+        "graphics/blocks/Stone.png",
+        "graphics/blocks/Dirt.png",
+        "graphics/blocks/Dirt_Grass.png",
+        "graphics/blocks/Tree_Trunk.png",
+        "graphics/blocks/Tree_Leaves.png",
+    };
+
+    Image images[TEXTURE_COUNT + 1];
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    for (int i = 0; i <= TEXTURE_COUNT; ++i) {
+        images[i] = i < TEXTURE_COUNT ? m_LoadBlockImage(paths[i]) : GenImageColor(2, 2, WHITE);
+        atlasWidth += images[i].width + 2 * atlasPadding;
+        atlasHeight = std::max(atlasHeight, images[i].height + 2 * atlasPadding);
+    }
+
+    Image atlasImage = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    float x = 0.0f;
+    for (int i = 0; i <= TEXTURE_COUNT; ++i) {
+        float w = (float)images[i].width;
+        float h = (float)images[i].height;
+        Rectangle cell = {x + atlasPadding, (float)atlasPadding, w, h};
+
+        ImageDraw(&atlasImage, images[i], {0.0f, 0.0f, w, h}, cell, WHITE);
+        ImageDraw(&atlasImage, images[i], {0.0f, 0.0f, 1.0f, h}, {cell.x - 1.0f, cell.y, 1.0f, h}, WHITE);
+        ImageDraw(&atlasImage, images[i], {w - 1.0f, 0.0f, 1.0f, h}, {cell.x + w, cell.y, 1.0f, h}, WHITE);
+        ImageDraw(&atlasImage, images[i], {0.0f, 0.0f, w, 1.0f}, {cell.x, cell.y - 1.0f, w, 1.0f}, WHITE);
+        ImageDraw(&atlasImage, images[i], {0.0f, h - 1.0f, w, 1.0f}, {cell.x, cell.y + h, w, 1.0f}, WHITE);
+
+        if (i < TEXTURE_COUNT) atlasRects[i] = cell;
+        else whiteRect = cell;
+        x += w + 2 * atlasPadding;
+        UnloadImage(images[i]);
+    }
+
+    atlas = backend.LoadTextureFromImage(atlasImage);
+    UnloadImage(atlasImage);
+    backend.SetTextureFilter(atlas, TEXTURE_FILTER_POINT);
 }
 
 void TextureManager::Unload() {
-    UnloadTexture(stoneTexture);
-    UnloadTexture(dirtTexture);
-    UnloadTexture(grassTexture);
-    UnloadTexture(trunkTexture);
-    UnloadTexture(leavesTexture);
+    GetDrawBackend().UnloadTexture(atlas);
+    atlas = Texture2D{};
 }
 
-void TextureManager::WorldTextureManager(int tile, int camX, int camY, int tilePixelX, int tilePixelY){
-    switch (tile) {
-        case World::TILE_STONE: 
-            m_RenderBlock(stoneTexture, tilePixelX, tilePixelY, camX, camY);
-            break;
-        case World::TILE_DIRT: 
-            m_RenderBlock(dirtTexture, tilePixelX, tilePixelY, camX, camY);
-            break;
-        case World::TILE_DIRT_GRASS: 
-            m_RenderBlock(grassTexture, tilePixelX, tilePixelY, camX, camY);
-            break;
-        case World::TILE_TREE_TRUNK: 
-            m_RenderBlock(trunkTexture, tilePixelX, tilePixelY, camX, camY);
-            break;
-        case World::TILE_TREE_LEAVES: 
-            m_RenderBlock(leavesTexture, tilePixelX, tilePixelY, camX, camY);
-            break;
-    }
+void TextureManager::BeginBatch() {
+    batch.clear();
 }
 
-void TextureManager::ItemTextureManager(int tile, int camX, int camY, int xPos, int yPos, int size, float hover){
-    switch (tile) {
-        case Item::BLOCK_STONE: 
-            m_RenderDroppedItem(stoneTexture, xPos, yPos, camX, camY, size, hover);
-            break;
-        case Item::BLOCK_DIRT: 
-            m_RenderDroppedItem(dirtTexture, xPos, yPos, camX, camY, size, hover);
-            break;
-        case Item::BLOCK_TREE_TRUNK: 
-            m_RenderDroppedItem(trunkTexture, xPos, yPos, camX, camY, size, hover);
-            break;
-        case Item::BLOCK_TREE_LEAVES: 
-            m_RenderDroppedItem(leavesTexture, xPos, yPos, camX, camY, size, hover);
-            break;
-    }
+void TextureManager::BatchSprite(int slot, Rectangle dest, Color tint) {
+    batch.push_back({atlasRects[slot], dest, tint});
 }
 
-void TextureManager::m_RenderBlock(Texture2D& texture, int tilePixelX, int tilePixelY, int camX, int camY) {
-    Rectangle src = {0.0f, 0.0f, (float)texture.width, (float)texture.height};
-    Rectangle dest = {(float)(tilePixelX - camX), (float)(tilePixelY - camY), (float)tileSize, (float)tileSize};
-    Vector2 origin = {0.0f, 0.0f};
-    DrawTexturePro(texture, src, dest, origin, 0.0f, WHITE);
+void TextureManager::BatchRect(Rectangle dest, Color color) {
+    batch.push_back({whiteRect, dest, color});
+}
+
+TexturedQuad* TextureManager::AppendToBatch(int count) {
+    size_t first = batch.size();
+    batch.resize(first + count);
+    return batch.data() + first;
 }
 
-void TextureManager::m_RenderDroppedItem(Texture2D& texture, int xPos, int yPos, int camX, int camY, int size, float hover) {
-    int offset = 2;
-    DrawRectangle((int)(xPos - camX) - offset + hover, (int)(yPos- camY) + offset + hover, (int)size, (int)size, BLACK);
-    Rectangle src = {0.0f, 0.0f, (float)texture.width, (float)texture.height};
-    Rectangle dest = {(float)(xPos - camX) + hover, (float)(yPos - camY) + hover, (float)size, (float)size};
-    Vector2 origin = {0.0f, 0.0f};
-    DrawTexturePro(texture, src, dest, origin, 0.0f, WHITE);
+Rectangle TextureManager::GetSpriteSource(int slot) const { return atlasRects[slot]; }
+Rectangle TextureManager::GetRectSource() const { return whiteRect; }
+
+// Every queued quad samples the atlas, so the whole batch is one bulk draw
+void TextureManager::FlushBatch() {
+    if (batch.empty()) return;
+
+    GetDrawBackend().DrawTextureQuads(atlas, batch.data(), batch.size());
+    ++batchStats.flushes;
+    batchStats.quads += batch.size();
+    batch.clear();
+}
+
+const TextureManager::BatchStats& TextureManager::getBatchStats() const { return batchStats; }
+void TextureManager::ResetBatchStats() { batchStats = BatchStats(); }
+
+void TextureManager::WorldTextureManager(int tile, int camX, int camY, int tilePixelX, int tilePixelY, Color tint){
+    int slot = World::GetTileInfo(tile).textureSlot;
+    if (slot < 0) return;
+    m_RenderBlock(slot, tilePixelX, tilePixelY, camX, camY, tint);
+}
+
+int TextureManager::GetItemSlot(int itemTexture) {
+    switch (itemTexture) {
+        case Item::BLOCK_STONE: return TEXTURE_STONE;
+        case Item::BLOCK_DIRT: return TEXTURE_DIRT;
+        case Item::BLOCK_TREE_TRUNK: return TEXTURE_TRUNK;
+        case Item::BLOCK_TREE_LEAVES: return TEXTURE_LEAVES;
+    }
+    return -1;
+}
+
+void TextureManager::m_RenderBlock(int slot, int tilePixelX, int tilePixelY, int camX, int camY, Color tint) {
+    Rectangle dest = {(float)(tilePixelX - camX), (float)(tilePixelY - camY), (float)tileSize, (float)tileSize};
+    BatchSprite(slot, dest, tint);
 }
 
-void TextureManager::m_LoadFilterTexture(const std::string& path, Texture2D& texture) {
-    texture = LoadTexture(path.c_str());
+// A missing sprite leaves its cell blank rather than failing the whole atlas
+Image TextureManager::m_LoadBlockImage(const std::string& path) {
+    Image image = LoadImage(path.c_str());
 
-    if (texture.id == 0) {
+    if (image.data == nullptr) {
         TraceLog(LOG_ERROR, "Failed to load texture: %s", path.c_str());
-        return;
+        UnloadImage(image);
+        return GenImageColor(1, 1, BLANK);
     }
-    SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+    return image;
 }
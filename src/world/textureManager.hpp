@@ -1,22 +1,64 @@
 #pragma once
 #include <raylib.h>
 #include <string>
+#include <vector>
+#include "../render/drawBackend.hpp"
 
+// Block sprites are packed into one atlas texture at load time, and every world and
+// item draw goes through a sprite batch over it. A batch is submitted as one bulk quad
+// draw against that single texture, so raylib keeps it in one draw call.
 class TextureManager {
 public:
+    enum TextureSlot {
+        TEXTURE_STONE,
+        TEXTURE_DIRT,
+        TEXTURE_GRASS,
+        TEXTURE_TRUNK,
+        TEXTURE_LEAVES,
+        TEXTURE_COUNT
+    };
+
+    struct BatchStats {
+        int flushes = 0; // non-empty FlushBatch calls
+        int quads = 0;
+    };
+
     void Load();
     void Unload();
 
-    void WorldTextureManager(int tile, int camX, int camY, int tilePixelX, int tilePixelY);
-    void ItemTextureManager(int tile, int camX, int camY, int xPos, int yPox, int size, float hover);
+    // Sprites queue until FlushBatch, which must run before the target or mode changes
+    void BeginBatch();
+    void BatchSprite(int slot, Rectangle dest, Color tint = WHITE);
+    void BatchRect(Rectangle dest, Color color); // solid colour from the atlas's white cell
+    TexturedQuad* AppendToBatch(int count);       // count quads for the caller to fill in place
+    Rectangle GetSpriteSource(int slot) const;
+    Rectangle GetRectSource() const;              // the white cell BatchRect uses
+    void FlushBatch();
+    const BatchStats& getBatchStats() const;
+    void ResetBatchStats();
+
+    void WorldTextureManager(int tile, int camX, int camY, int tilePixelX, int tilePixelY, Color tint = WHITE);
+
+    // Dropped item layout for ItemManager's bulk pass
+    static int GetItemSlot(int itemTexture); // Item::ItemRenderType to TextureSlot, -1 for none
+    static void GetDroppedItemRects(int xPos, int yPos, int camX, int camY, int size, float hover,
+                                    Rectangle& shadow, Rectangle& sprite);
 private:
-    void m_LoadFilterTexture(const std::string& path, Texture2D& texture );
-    void m_RenderBlock(Texture2D& texture, int tilePixelX, int tilePixelY, int camX, int camY);
-    void m_RenderDroppedItem(Texture2D& texture, int xPos, int yPos, int camX, int camY, int size, float hover);
-
-    Texture2D stoneTexture;
-    Texture2D dirtTexture;
-    Texture2D grassTexture;
-    Texture2D trunkTexture;
-    Texture2D leavesTexture;
+    Image m_LoadBlockImage(const std::string& path);
+    void m_RenderBlock(int slot, int tilePixelX, int tilePixelY, int camX, int camY, Color tint);
+
+    static constexpr int atlasPadding = 1; // border of repeated sprite edges, stops bleeding
+    Texture2D atlas{};
+    Rectangle atlasRects[TEXTURE_COUNT] = {};
+    Rectangle whiteRect = {};
+    std::vector<TexturedQuad> batch;
+    BatchStats batchStats;
 };
+
+inline void TextureManager::GetDroppedItemRects(int xPos, int yPos, int camX, int camY, int size, float hover,
+                                                Rectangle& shadow, Rectangle& sprite) {
+    int offset = 2;
+    shadow = {(float)(int)((xPos - camX) - offset + hover), (float)(int)((yPos - camY) + offset + hover),
+              (float)size, (float)size};
+    sprite = {(float)(xPos - camX) + hover, (float)(yPos - camY) + hover, (float)size, (float)size};
+}
@@ -2,25 +2,191 @@
 #include "world.hpp"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <raylib.h>
 #include "../util/perlin.hpp"
 #include "../util/utils.hpp"
 #include "../util/globals.hpp"
+#include "../util/hash.hpp"
 #include "textureManager.hpp"
 
 // You need to define this in one .cpp file
 //int tileSize = 16;
 
-World::World() :  perlin(generateRandomSeed()), tiles(width * height, 0) {
+// Every random decision during generation comes from a stream keyed by the world seed,
+// the absolute chunk column and the pass, so a column regenerates identically.
+enum GenPass : unsigned int {
+    PASS_BASIC = 1,
+    PASS_WORMS,
+    PASS_SURFACE,
+    PASS_TREES,
+};
+
+static std::mt19937 ColumnRng(unsigned int seed, int column, unsigned int pass) {
+    std::seed_seq seq{seed, static_cast<unsigned int>(column), pass};
+    return std::mt19937(seq);
+}
+
+static constexpr uint32_t TileBit(int tile) { return 1u << tile; }
+static constexpr uint32_t anyTile = (1u << World::TILE_COUNT) - 1;
+
+World::World(unsigned int seed, int width, int height)
+    : seed(seed),
+      perlin(seed),
+      width(width),
+      height(height),
+      chunksX((width + chunkSize - 1) / chunkSize),
+      chunksY((height + chunkSize - 1) / chunkSize),
+      chunks(chunksX * chunksY),
+      topSolid(width, height),
+      topNonAir(width, height),
+      columnReady(chunksX) {
+    for (Chunk& chunk : chunks) {
+        m_OwnTiles(chunk);
+    }
+    for (std::atomic<bool>& ready : columnReady) {
+        ready = true;
+    }
+    readyColumns = chunksX;
+
+    // Passes run in this order unless they touch disjoint tile types. reads lists what a
+    // pass inspects or overwrites, so a pass that carves through anything reads anyTile.
+    // Passes after "surface index" that change the top of a column must update it, and
+    // passes after "occupancy" must keep the chunk bitmasks current.
+    generationPipeline.AddPass({ "basic terrain", TileBit(TILE_AIR),
+                                 TileBit(TILE_AIR) | TileBit(TILE_STONE) | TileBit(TILE_DIRT),
+                                 [](World& w, int x0, int x1) { w.InitBasicGen(x0, x1); } });
+    generationPipeline.AddPass({ "worms", anyTile, TileBit(TILE_AIR),
+                                 [](World& w, int x0, int x1) { w.AddRandWorms(x0, x1); } });
+    generationPipeline.AddPass({ "dirt patches", TileBit(TILE_STONE), TileBit(TILE_DIRT),
+                                 [](World& w, int x0, int x1) { w.AddDirtPatches(x0, x1); } });
+    generationPipeline.AddPass({ "surface clear", anyTile, TileBit(TILE_AIR),
+                                 [](World& w, int x0, int x1) { w.ClearTopRowsToAir(x0, x1, 0.00000000001); } });
+    generationPipeline.AddPass({ "surface index", anyTile, 0,
+                                 [](World& w, int x0, int x1) { w.UpdateSurface(x0, x1); } });
+    generationPipeline.AddPass({ "occupancy", anyTile, 0,
+                                 [](World& w, int x0, int x1) { w.m_BuildOccupancy(x0 >> chunkShift); } });
+    generationPipeline.AddPass({ "grass", TileBit(TILE_AIR) | TileBit(TILE_DIRT), TileBit(TILE_DIRT_GRASS),
+                                 [](World& w, int x0, int x1) { w.AddGrass(x0, x1); } });
+    generationPipeline.AddPass({ "trees", anyTile, TileBit(TILE_TREE_TRUNK) | TileBit(TILE_TREE_LEAVES),
+                                 [](World& w, int x0, int x1) { w.AddTrees(x0, x1); } });
 }
 
 World::~World() {
+    FinishGenerating();
+}
+
+// Gives a chunk its own tile block, copying whatever it pointed at (e.g. a mapped save)
+// or expanding its compressed form
+void World::m_OwnTiles(Chunk& chunk) {
+    if (chunk.storage) return;
+    chunk.storage = std::make_unique<uint8_t[]>(chunkArea);
+    if (chunk.tiles) {
+        std::copy(chunk.tiles, chunk.tiles + chunkArea, chunk.storage.get());
+    } else if (chunk.compressed) {
+        chunk.compressed->Decompress(chunk.storage.get());
+    } else {
+        std::fill_n(chunk.storage.get(), chunkArea, TILE_AIR);
+    }
+    chunk.compressed.reset();
+    chunk.tiles = chunk.storage.get();
+}
+
+// Tiles of a chunk for reading in bulk, decoded into scratch when it is compressed
+const uint8_t* World::m_ReadTiles(const Chunk& chunk, uint8_t* scratch) const {
+    if (chunk.tiles) return chunk.tiles;
+    chunk.compressed->Decompress(scratch);
+    return scratch;
+}
+
+// Light is compressed whether or not the tiles are, and stays expanded when it uses
+// more levels than a palette holds
+bool World::CompressChunk(int chunkX, int chunkY) {
+    Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+    m_CompressLight(chunk);
+    if (chunk.compressed) return true;
+
+    auto compressed = std::make_unique<CompressedChunk>();
+    if (!CompressedChunk::Compress(chunk.tiles, *compressed)) return false;
+
+    chunk.compressed = std::move(compressed);
+    chunk.storage.reset();
+    chunk.tiles = nullptr;
+    return true;
 }
 
-int& World::at(int x, int y) {
-    return tiles[y * width + x];
+void World::DecompressChunk(int chunkX, int chunkY) {
+    Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+    if (chunk.compressed) m_OwnTiles(chunk);
+    if (chunk.compressedLight) m_ExpandLight(chunk);
+}
+
+// Sweeps a slice of the chunks each call. Chunks near the focus are kept expanded so
+// collision and rendering read plain arrays; chunks away from it that have gone
+// coldSweeps sweeps without an edit are compressed.
+void World::UpdateCompression(int focusTileX, int focusTileY) {
+    if (generating) return;
+
+    int focusChunkX = focusTileX >> chunkShift;
+    int focusChunkY = focusTileY >> chunkShift;
+    int count = std::min<int>(compressionSweepChunks, chunks.size());
+
+    for (int n = 0; n < count; ++n) {
+        int index = compressionCursor;
+        compressionCursor = (compressionCursor + 1) % chunks.size();
+
+        Chunk& chunk = chunks[index];
+        if (chunk.version != chunk.seenVersion) {
+            chunk.seenVersion = chunk.version;
+            chunk.idleSweeps = 0;
+        } else if (chunk.idleSweeps < coldSweeps) {
+            chunk.idleSweeps++;
+        }
+
+        int cx = index % chunksX;
+        int cy = index / chunksX;
+        bool hot = std::abs(cx - focusChunkX) <= hotRadiusChunks && std::abs(cy - focusChunkY) <= hotRadiusChunks;
+        if (hot) {
+            if (chunk.compressed) m_OwnTiles(chunk);
+            if (chunk.compressedLight) m_ExpandLight(chunk);
+        } else if (chunk.idleSweeps >= coldSweeps) {
+            CompressChunk(cx, cy);
+        }
+    }
+}
+
+World::CompressionStats World::GetCompressionStats() const {
+    CompressionStats stats;
+    stats.rawBytes = chunks.size() * chunkArea * 2;
+    for (const Chunk& chunk : chunks) {
+        if (chunk.compressed) {
+            stats.compressedChunks++;
+            stats.residentBytes += chunk.compressed->ByteSize();
+        } else {
+            stats.residentBytes += chunkArea;
+        }
+
+        if (chunk.light) {
+            stats.lightBytes += chunkArea;
+        } else if (chunk.compressedLight) {
+            stats.lightBytes += chunk.compressedLight->ByteSize();
+        } else {
+            stats.uniformLightChunks++;
+        }
+    }
+    stats.residentBytes += stats.lightBytes;
+    return stats;
+}
+
+uint8_t& World::TileRef(int x, int y) {
+    Chunk& chunk = chunks[(y >> chunkShift) * chunksX + (x >> chunkShift)];
+    if (!chunk.tiles) m_OwnTiles(chunk);
+    return chunk.tiles[(y & chunkMask) * chunkSize + (x & chunkMask)];
 }
 
 int World::MapYToRadius(float y, int minRadius, int maxRadius) {
@@ -29,21 +195,51 @@ int World::MapYToRadius(float y, int minRadius, int maxRadius) {
 }
 
 bool World::IsSolidTile(int tileX, int tileY) const {
-    if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height) return false;
-    int tile = tiles[tileY * width + tileX];
-    return tile == TILE_STONE || tile == TILE_DIRT || tile == TILE_DIRT_GRASS;
+    // unsigned compare folds the negative checks into the upper bound
+    if ((unsigned)tileX >= (unsigned)width || (unsigned)tileY >= (unsigned)height) return false;
+    return m_AnyUnready(tileX, tileX) || tileInfo[GetTile(tileX, tileY)].solid;
+}
+
+bool World::m_IsSolid(int x, int y) const {
+    if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height) return false;
+    return tileInfo[GetTile(x, y)].solid;
 }
 
 bool World::IsTile(int tileX, int tileY) const {
-    if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height) return false;
-    int tile = tiles[tileY * width + tileX];
-    return tile == TILE_STONE || tile == TILE_DIRT || tile == TILE_DIRT_GRASS || tile == TILE_TREE_TRUNK ||
-        tile == TILE_TREE_LEAVES;
+    return CanEdit(tileX, tileY) && tileInfo[GetTile(tileX, tileY)].breakable;
 }
 
-void World::AddPerlinWorm(int startX, int startY, int length, float noiseScale, int minRadius, int maxRadius) {
-    float posX = static_cast<float>(startX);
-    float posY = static_cast<float>(startY);
+bool World::CanEdit(int tileX, int tileY) const {
+    if ((unsigned)tileX >= (unsigned)width || (unsigned)tileY >= (unsigned)height) return false;
+    return !m_AnyUnready(tileX - chunkSize, tileX + chunkSize);
+}
+
+// generating is cleared only after every column is ready, so one load settles the common case
+bool World::m_AnyUnready(int x0, int x1) const {
+    if (!generating) return false;
+    int first = std::max(x0, 0) >> chunkShift;
+    int last = std::min(x1, width - 1) >> chunkShift;
+    for (int cx = first; cx <= last; ++cx) {
+        if (!columnReady[cx]) return true;
+    }
+    return false;
+}
+
+// startX is an absolute tile column; only tiles in the local columns [x0, x1) are carved.
+void World::AddPerlinWorm(int startX, int startY, int length, float noiseScale, int minRadius, int maxRadius, int x0, int x1) {
+    std::vector<WormDisc> path;
+    m_TraceWorm(startX, startY, length, noiseScale, minRadius, maxRadius, path);
+
+    std::vector<TileSpan> spans;
+    m_WormSpans(path, x0, x1, spans);
+    m_FillAir(spans);
+}
+
+// Follows a worm and records the disc every step carves, in absolute tile columns
+void World::m_TraceWorm(int startX, int startY, int length, float noiseScale, int minRadius, int maxRadius,
+                        std::vector<WormDisc>& path) {
+    double posX = static_cast<double>(startX);
+    double posY = static_cast<double>(startY);
 
     for (int i = 0; i < length; ++i) {
         float angle = perlin.noise(posX * noiseScale, posY * noiseScale) * 2.0f * 3.14159f;
@@ -51,79 +247,171 @@ void World::AddPerlinWorm(int startX, int startY, int length, float noiseScale,
         posX += cos(angle);
         posY += sin(angle);
 
-        int centerX = static_cast<int>(posX);
-        int centerY = static_cast<int>(posY);
-
         int radius = MapYToRadius(posY, minRadius, maxRadius);
+        path.push_back({ static_cast<int>(std::floor(posX)), static_cast<int>(posY), radius });
+    }
+}
 
-        for (int y = -radius; y <= radius; ++y) {
-            for (int x = -radius; x <= radius; ++x) {
-                int nx = centerX + x;
-                int ny = centerY + y;
+// The worm a source column starts, empty if it starts none. Each worm reaches up to
+// wormReachChunks columns either side, so paths are traced once and shared by them all.
+std::shared_ptr<const std::vector<World::WormDisc>> World::m_WormPath(int sourceColumn) {
+    {
+        std::lock_guard<std::mutex> lock(wormPathMutex);
+        auto it = wormPaths.find(sourceColumn);
+        if (it != wormPaths.end()) return it->second;
+    }
 
-                if (nx >= 0 && nx < width && ny >= 0 && ny < height && x * x + y * y <= radius * radius) {
-                    tiles[ny * width + nx] = TILE_AIR;
-                }
-            }
-        }
+    auto path = std::make_shared<std::vector<WormDisc>>();
+    std::mt19937 rng = ColumnRng(seed, sourceColumn, PASS_WORMS);
+    if (rng() % 3 != 0) { // about two in three columns start a worm
+        int startX = sourceColumn * chunkSize + rng() % chunkSize;
+        int startY = 10 + rng() % (height - 20);
+
+        int length = 100 + rng() % 100;
+        float scale = 0.05f + static_cast<float>(rng()) / std::mt19937::max() * 0.1f;
+
+        int minRadius = 1;
+        int maxRadius = 4 + rng() % 3;
+
+        m_TraceWorm(startX, startY, length, scale, minRadius, maxRadius, *path);
     }
+
+    // Another thread may have traced it meanwhile; both results are identical
+    std::lock_guard<std::mutex> lock(wormPathMutex);
+    return wormPaths.emplace(sourceColumn, std::move(path)).first->second;
 }
 
-void World::AddRandWorms(int minWorms, int maxWorms) {
-    if (maxWorms < minWorms) std::swap(minWorms, maxWorms);
+// Cuts every disc x*x + y*y <= r*r of a path into one span per row, clipped to [x0, x1)
+void World::m_WormSpans(const std::vector<WormDisc>& path, int x0, int x1, std::vector<TileSpan>& spans) const {
+    for (const WormDisc& disc : path) {
+        int centerX = disc.x - originChunkX * chunkSize;
+        if (centerX + disc.radius < x0 || centerX - disc.radius >= x1) continue;
 
-    int numWorms = minWorms + rand() % (maxWorms - minWorms + 1);
+        int radiusSq = disc.radius * disc.radius;
+        int half = disc.radius;
+        for (int dy = 0; dy <= disc.radius; ++dy) {
+            while (half * half + dy * dy > radiusSq) --half; // widest x on this row
 
-    for (int i = 0; i < numWorms; ++i) {
-        int startX = 10 + rand() % (width - 20);
-        int startY = 10 + rand() % (height - 20);
+            int left = std::max(centerX - half, x0);
+            int right = std::min(centerX + half, x1 - 1);
+            if (left > right) continue;
 
-        int length = 100 + rand() % 100;
-        float scale = 0.05f + static_cast<float>(rand()) / RAND_MAX * 0.1f;
+            if (disc.y - dy >= 0 && disc.y - dy < height) spans.push_back({ disc.y - dy, left, right });
+            if (dy > 0 && disc.y + dy >= 0 && disc.y + dy < height) spans.push_back({ disc.y + dy, left, right });
+        }
+    }
+}
 
-        int minRadius = 1;
-        int maxRadius = 4 + rand() % 3;
+// Consecutive worm steps overlap almost entirely, so spans are merged per row and every
+// run of air is written once instead of stamping each disc
+void World::m_FillAir(std::vector<TileSpan>& spans) {
+    std::sort(spans.begin(), spans.end());
 
-        AddPerlinWorm(startX, startY, length, scale, minRadius, maxRadius);
+    for (size_t i = 0; i < spans.size();) {
+        TileSpan run = spans[i];
+        for (++i; i < spans.size() && spans[i].y == run.y && spans[i].left <= run.right + 1; ++i) {
+            run.right = std::max(run.right, spans[i].right);
+        }
+
+        // Tiles are contiguous only within a chunk row
+        for (int x = run.left; x <= run.right;) {
+            int count = std::min(run.right, x | chunkMask) - x + 1;
+            std::fill_n(&TileRef(x, run.y), count, TILE_AIR);
+            x += count;
+        }
     }
 }
 
-void World::AddDirtPatches(float noiseScale, float threshold) {
+// Worms start in a chunk column and can wander up to wormReachChunks columns away, so
+// every column within reach is asked whether it starts a worm that carves into [x0, x1).
+void World::AddRandWorms(int x0, int x1) {
+    int column = originChunkX + (x0 >> chunkShift);
+
+    // Every worm within reach is traced (or fetched) before anything is carved, so the
+    // caves of all of them are filled as one set of spans
+    std::vector<TileSpan> spans;
+    for (int source = column - wormReachChunks; source <= column + wormReachChunks; ++source) {
+        m_WormSpans(*m_WormPath(source), x0, x1, spans);
+    }
+    m_FillAir(spans);
+}
+
+void World::AddDirtPatches(int x0, int x1, float noiseScale, float threshold) {
+    double originX = originChunkX * chunkSize + x0;
+    std::vector<float> row(x1 - x0);
+
     for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int idx = y * width + x;
-            if (tiles[idx] == TILE_STONE) {
-                float noiseVal = perlin.noise(x * noiseScale, y * noiseScale);
+        perlin.NoiseRow(originX * noiseScale, noiseScale, y * noiseScale, row.data(), x1 - x0);
+        for (int x = x0; x < x1; ++x) {
+            uint8_t& tile = TileRef(x, y);
+            if (tile == TILE_STONE) {
+                float noiseVal = row[x - x0];
                 float normalized = (noiseVal + 1.0f) / 2.0f;
                 if (normalized > threshold) {
-                    tiles[idx] = TILE_DIRT;
+                    tile = TILE_DIRT;
                 }
             }
         }
     }
 }
 
-void World::ClearTopRowsToAir(float scale) {
+void World::ClearTopRowsToAir(int x0, int x1, float scale) {
     float bandScale = 0.01f;
+    std::mt19937 rng = ColumnRng(seed, originChunkX + (x0 >> chunkShift), PASS_SURFACE);
 
-    for (int x = 0; x < width; x++) {
-        float noiseVal = perlin.noise(x * scale, 0.01f * (float)(rand() % 2));
+    for (int x = x0; x < x1; x++) {
+        double worldX = originChunkX * chunkSize + x;
+        float noiseVal = perlin.noise(worldX * scale, 0.01f * (float)(rng() % 2));
         int clearHeight = mapNoiseToRange(noiseVal, 80, 180);
 
-        float xBandNoise = perlin.noise(x * bandScale, 0.0f);
+        float xBandNoise = perlin.noise(worldX * bandScale, 0.0f);
         int bandOffset = (int)((xBandNoise - 0.5f) * 20);
 
         clearHeight += bandOffset;
         clearHeight = std::clamp(clearHeight, 0, height);
 
         for (int y = 0; y < clearHeight; y++) {
-            tiles[y * width + x] = TILE_AIR;
+            TileRef(x, y) = TILE_AIR;
         }
     }
 }
 
-void World::InitBasicGen(float scale, float threshold) {
-    int octaves = 5;
+void World::InitBasicGen(int x0, int x1, float scale, float threshold) {
+    constexpr int octaves = 5;
+    const int columnWidth = x1 - x0;
+    std::mt19937 rng = ColumnRng(seed, originChunkX + (x0 >> chunkShift), PASS_BASIC);
+
+    float frequencies[octaves];
+    float amplitudes[octaves];
+    float maxAmplitude = -1.5f;
+    float frequency = scale;
+    float amplitude = 1.0f;
+    for (int o = 0; o < octaves; ++o) {
+        frequencies[o] = frequency;
+        amplitudes[o] = amplitude;
+        maxAmplitude += amplitude;
+        frequency *= 2.0f;
+        amplitude *= 0.5f;
+    }
+
+    // Both dirt depth noises depend only on x and one of two y offsets picked per tile,
+    // so every variant is sampled once per column instead of once per tile
+    std::vector<int> dirtHeights[2];
+    std::vector<int> dirtHeights2[2];
+    for (int pick = 0; pick < 2; ++pick) {
+        dirtHeights[pick].resize(columnWidth);
+        dirtHeights2[pick].resize(columnWidth);
+        for (int x = x0; x < x1; ++x) {
+            double worldX = originChunkX * chunkSize + x;
+            float dirtNoiseVal = perlin.noise(worldX * 0.01f, 0.05f * (float)pick);
+            dirtHeights[pick][x - x0] = mapNoiseToRange(dirtNoiseVal, 70, dirtDepth);
+            float dirtNoiseVal2 = perlin.noise(worldX * 0.01f, 0.0001f * (float)pick);
+            dirtHeights2[pick][x - x0] = mapNoiseToRange(dirtNoiseVal2, 90, 120);
+        }
+    }
+
+    double originX = originChunkX * chunkSize + x0;
+    std::vector<float> layers(octaves * columnWidth);
 
     for (int y = 0; y < height; ++y) {
         float yFactor = (float)y / (float)height;
@@ -131,64 +419,46 @@ void World::InitBasicGen(float scale, float threshold) {
         float airBias = pow(surfaceFactor, 2.0f);
         float adjustedThreshold = threshold + airBias * 0.5f;
 
-        for (int x = 0; x < width; ++x) {
-            float noiseVal = 0.0f;
-            float frequency = scale;
-            float amplitude = 1.0f;
-            float maxAmplitude = -1.5f;
+        for (int o = 0; o < octaves; ++o) {
+            perlin.NoiseRow(originX * frequencies[o], frequencies[o], y * frequencies[o],
+                            &layers[o * columnWidth], columnWidth);
+        }
 
+        for (int x = x0; x < x1; ++x) {
+            float noiseVal = 0.0f;
             for (int o = 0; o < octaves; ++o) {
-                float nx = x * frequency;
-                float ny = y * frequency;
-                float layerNoise = perlin.noise(nx, ny) * amplitude;
-                noiseVal += layerNoise;
-                maxAmplitude += amplitude;
-
-                frequency *= 2.0f;
-                amplitude *= 0.5f;
+                noiseVal += layers[o * columnWidth + x - x0] * amplitudes[o];
             }
 
             if (maxAmplitude > 0.0f)
                 noiseVal /= maxAmplitude;
 
-            float dirtNoiseVal = perlin.noise(x * 0.01f, 0.05f * (float)(rand() % 2));
-            int dirtHeight = mapNoiseToRange(dirtNoiseVal, 70, dirtDepth);
+            int dirtHeight = dirtHeights[rng() % 2][x - x0];
 
             if (noiseVal > adjustedThreshold) {
                 if (y < dirtHeight) {
-                    tiles[y * width + x] = TILE_DIRT;
+                    TileRef(x, y) = TILE_DIRT;
                 } else {
-                    tiles[y * width + x] = TILE_STONE;
+                    TileRef(x, y) = TILE_STONE;
                 }
             } else {
-                tiles[y * width + x] = TILE_AIR;
+                TileRef(x, y) = TILE_AIR;
             }
 
-            float dirtNoiseVal2 = perlin.noise(x * 0.01f, 0.0001f * (float)(rand() % 2));
-            int dirtHeight2 = mapNoiseToRange(dirtNoiseVal2, 90, 120);
+            int dirtHeight2 = dirtHeights2[rng() % 2][x - x0];
             if (y < dirtHeight2) {
-                tiles[y * width + x] = TILE_DIRT;
+                TileRef(x, y) = TILE_DIRT;
             }
         }
     }
 }
 
-void World::AddGrass() {
-    for (int y = 5; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            if (at(x,y) == TILE_DIRT) {
-                bool enoughAirAbove = true;
-                int numOfAirAbove = 5;
-                for (int i = 1; i <= numOfAirAbove; i++) {
-                    if (at(x, y - i) != TILE_AIR) {
-                        enoughAirAbove = false;
-                        break;
-                    }
-                }
-                    if (enoughAirAbove) {
-                        at(x,y) = TILE_DIRT_GRASS;
-                    }
-            }
+// Dirt at the top of its column turns to grass when it has at least 5 rows of sky
+void World::AddGrass(int x0, int x1) {
+    for (int x = x0; x < x1; x++) {
+        int y = topNonAir[x];
+        if (y >= 5 && y < height && GetTile(x, y) == TILE_DIRT) {
+            TileRef(x, y) = TILE_DIRT_GRASS;
         }
     }
 }
@@ -199,7 +469,7 @@ void World::DrawTileLine(int x0, int y0, int x1, int y1, int tileType) {
     int err = dx + dy;
 
     while (true) {
-        at(x0, y0) = tileType;
+        m_PlaceTreeTile(x0, y0, tileType);
 
         if (x0 == x1 && y0 == y1) break;
         int e2 = 2 * err;
@@ -221,7 +491,7 @@ bool World::CanPlaceFractalTree(int x, int y, float angle, float length, int dep
 
     int cx = x, cy = y;
     while (true) {
-        if (IsSolidTile(cx, cy)) return false;
+        if (m_IsSolid(cx, cy)) return false;
 
         if (cx == x2 && cy == y2) break;
         int e2 = 2 * err;
@@ -237,6 +507,30 @@ bool World::CanPlaceFractalTree(int x, int y, float angle, float length, int dep
            CanPlaceFractalTree(x2, y2, angle + angleOffset, newLength, depth - 1);
 }
 
+// The box spanned by the trunk line endpoints CanPlaceFractalTree visits, using the same
+// integer endpoints; every tile it tests lies inside
+void World::m_TreeBounds(int x, int y, float angle, float length, int depth,
+                         int& minX, int& minY, int& maxX, int& maxY) const {
+    if (depth <= 0 || length < 1.0f) return;
+
+    int x2 = (int)(x + cosf(angle) * length);
+    int y2 = (int)(y + sinf(angle) * length);
+    minX = std::min(minX, x2);
+    minY = std::min(minY, y2);
+    maxX = std::max(maxX, x2);
+    maxY = std::max(maxY, y2);
+
+    float newLength = length * 0.7f;
+    float angleOffset = 0.5f;
+    m_TreeBounds(x2, y2, angle - angleOffset, newLength, depth - 1, minX, minY, maxX, maxY);
+    m_TreeBounds(x2, y2, angle + angleOffset, newLength, depth - 1, minX, minY, maxX, maxY);
+}
+
+void World::m_PlaceTreeTile(int x, int y, int tile) {
+    TileRef(x, y) = tile;
+    m_MarkOccupancy(x, y, tile);
+}
+
 void World::PlaceLeafCluster(int x, int y) {
     // Offsets for a 3x3 block around (x,y)
     static const int offsets[9][2] = {
@@ -253,8 +547,8 @@ void World::PlaceLeafCluster(int x, int y) {
         if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
 
         // Only place leaf if air
-        if (at(nx, ny) == TILE_AIR) {
-            at(nx, ny) = TILE_TREE_LEAVES;
+        if (GetTile(nx, ny) == TILE_AIR) {
+            m_PlaceTreeTile(nx, ny, TILE_TREE_LEAVES);
         }
     }
 }
@@ -278,82 +572,683 @@ void World::AddFractalTree(int x, int y, float angle, float length, int depth) {
     AddFractalTree((int)x2, (int)y2, angle + angleOffset, newLength, depth - 1);
 }
 
-void World::AddTrees() {
-    for (int y = 15; y < height; ++y) { // so we can safely look 15 tiles up
-        for (int x = 0; x < width; ++x) {
-            if (at(x, y) == TILE_DIRT_GRASS) {
-                // Check 15 air tiles above
-                bool allAboveAreAir = true;
-                for (int i = 1; i <= 15; ++i) {
-                    if (at(x, y - i) != TILE_AIR) {
-                        allAboveAreAir = false;
-                        break;
-                    }
-                }
+// Trees are rooted at least treeReach tiles inside their chunk column so a column never
+// depends on trees from its neighbours.
+void World::AddTrees(int x0, int x1) {
+    std::mt19937 rng = ColumnRng(seed, originChunkX + (x0 >> chunkShift), PASS_TREES);
+
+    // Grass only grows on the surface, so each tile column has at most one root. Visiting
+    // them top row first, then left to right, keeps the order of a full grid scan.
+    std::vector<std::pair<int, int>> roots;
+    for (int x = x0 + treeReach; x < x1 - treeReach; ++x) {
+        int y = topNonAir[x];
+        if (y >= 15 && y < height && GetTile(x, y) == TILE_DIRT_GRASS) { // so we can safely look 15 tiles up
+            roots.push_back({ y, x });
+        }
+    }
+    std::sort(roots.begin(), roots.end());
+
+    for (const auto& [y, x] : roots) {
+        // 15 air tiles above; leaves of trees placed earlier can be in the way
+        bool allAboveAreAir = !m_AnyOccupied(x, y - 15, x, y - 1, false);
+
+        // 15% chance
+        if (allAboveAreAir && (rng() % 100 < 15)) {
+            float baseAngle = -PI / 2.0f; // straight up
+            float angleVariance = ((rng() % 100) / 100.0f - 0.5f) * 0.3f; // random between -0.15 and +0.15
+            float randomAngle = baseAngle + angleVariance;
+
+            // A tree whose whole trunk box is free of solids fits without walking its lines
+            int minX = x, minY = y - 1, maxX = x, maxY = y - 1;
+            m_TreeBounds(x, y - 1, randomAngle, 4.0f, 3, minX, minY, maxX, maxY);
+            if (!m_AnyOccupied(minX, minY, maxX, maxY, true) || CanPlaceFractalTree(x, y - 1, randomAngle, 4.0f, 3))
+            AddFractalTree(x, y - 1, randomAngle, 4.0f, 3); // spawn tree going up
+        }
+    }
 
-                // 15% chance
-                if (allAboveAreAir && (rand() % 100 < 15)) {
-                    float baseAngle = -PI / 2.0f; // straight up
-                    float angleVariance = ((rand() % 100) / 100.0f - 0.5f) * 0.3f; // random between -0.15 and +0.15
-                    float randomAngle = baseAngle + angleVariance;
-                    if (CanPlaceFractalTree(x, y - 1, randomAngle, 4.0f, 3))
-                    AddFractalTree(x, y - 1, randomAngle, 4.0f, 3); // spawn tree going up
-                }
+    UpdateSurface(x0, x1); // trees rise above the old surface
+}
+
+int World::GetTopSolidY(int x) const { return m_AnyUnready(x, x) ? 0 : topSolid[x]; }
+int World::GetTopNonAirY(int x) const { return m_AnyUnready(x, x) ? 0 : topNonAir[x]; }
+
+// First row at or below fromY holding a solid (or any non-air) tile, height if none
+int World::m_ScanDown(int x, int fromY, bool solidOnly) const {
+    for (int y = fromY; y < height; ++y) {
+        int tile = GetTile(x, y);
+        if (solidOnly ? tileInfo[tile].solid : tile != TILE_AIR) return y;
+    }
+    return height;
+}
+
+void World::UpdateSurface(int x0, int x1) {
+    for (int x = x0; x < x1; ++x) {
+        topNonAir[x] = m_ScanDown(x, 0, false);
+        topSolid[x] = m_ScanDown(x, topNonAir[x], true);
+    }
+}
+
+// Generation calls m_AnyOccupied directly, as it works on columns that aren't ready yet
+bool World::AnySolid(int x0, int y0, int x1, int y1) const {
+    return m_AnyUnready(x0, x1) || m_AnyOccupied(x0, y0, x1, y1, true);
+}
+
+bool World::IsAllAir(int x0, int y0, int x1, int y1) const {
+    return !m_AnyUnready(x0, x1) && !m_AnyOccupied(x0, y0, x1, y1, false);
+}
+
+bool World::m_AnyOccupied(int x0, int y0, int x1, int y1, bool solidOnly) const {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width - 1);
+    y1 = std::min(y1, height - 1);
+
+    for (int cy = y0 >> chunkShift; cy <= y1 >> chunkShift; ++cy) {
+        int rowLo = std::max(y0 - cy * chunkSize, 0);
+        int rowHi = std::min(y1 - cy * chunkSize, chunkMask);
+        uint32_t rows = (0xFFFFFFFFu >> (chunkMask - rowHi)) & (0xFFFFFFFFu << rowLo);
+
+        for (int x = x0; x <= x1; ++x) {
+            const Chunk& chunk = chunks[cy * chunksX + (x >> chunkShift)];
+            uint32_t column = solidOnly ? chunk.solidColumns[x & chunkMask] : chunk.nonAirColumns[x & chunkMask];
+            if (column & rows) return true;
+        }
+    }
+    return false;
+}
+
+int World::FindSolidRow(int x0, int x1, int fromY, int toY) const {
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width - 1);
+    int lo = std::max(std::min(fromY, toY), 0);
+    int hi = std::min(std::max(fromY, toY), height - 1);
+    if (x0 > x1 || lo > hi) return -1;
+
+    bool down = fromY <= toY;
+    if (m_AnyUnready(x0, x1)) return down ? lo : hi;
+    int firstChunk = (down ? lo : hi) >> chunkShift;
+    int lastChunk = (down ? hi : lo) >> chunkShift;
+    for (int cy = firstChunk;; cy += down ? 1 : -1) {
+        int rowLo = std::max(lo - cy * chunkSize, 0);
+        int rowHi = std::min(hi - cy * chunkSize, chunkMask);
+        uint32_t solid = 0;
+        for (int x = x0; x <= x1; ++x) {
+            solid |= chunks[cy * chunksX + (x >> chunkShift)].solidColumns[x & chunkMask];
+        }
+        solid &= (0xFFFFFFFFu >> (chunkMask - rowHi)) & (0xFFFFFFFFu << rowLo);
+        if (solid) return cy * chunkSize + (down ? __builtin_ctz(solid) : chunkMask - __builtin_clz(solid));
+        if (cy == lastChunk) return -1;
+    }
+}
+
+int World::FindSolidColumn(int y0, int y1, int fromX, int toX) const {
+    int lo = std::max(std::min(fromX, toX), 0);
+    int hi = std::min(std::max(fromX, toX), width - 1);
+    if (fromX <= toX) {
+        for (int x = lo; x <= hi; ++x) {
+            if (AnySolid(x, y0, x, y1)) return x;
+        }
+    } else {
+        for (int x = hi; x >= lo; --x) {
+            if (AnySolid(x, y0, x, y1)) return x;
+        }
+    }
+    return -1;
+}
+
+void World::m_BuildOccupancy(int chunkX) {
+    uint8_t scratch[chunkArea];
+    for (int cy = 0; cy < chunksY; ++cy) {
+        Chunk& chunk = chunks[cy * chunksX + chunkX];
+        const uint8_t* tiles = m_ReadTiles(chunk, scratch);
+
+        std::fill_n(chunk.solidColumns, chunkSize, 0u);
+        std::fill_n(chunk.nonAirColumns, chunkSize, 0u);
+        for (int ly = 0; ly < chunkSize; ++ly) {
+            for (int lx = 0; lx < chunkSize; ++lx) {
+                int tile = tiles[ly * chunkSize + lx];
+                chunk.solidColumns[lx] |= (uint32_t)tileInfo[tile].solid << ly;
+                chunk.nonAirColumns[lx] |= (uint32_t)(tile != TILE_AIR) << ly;
             }
         }
     }
 }
 
+void World::m_MarkOccupancy(int x, int y, int tile) {
+    Chunk& chunk = chunks[(y >> chunkShift) * chunksX + (x >> chunkShift)];
+    uint32_t bit = 1u << (y & chunkMask);
+    uint32_t& solid = chunk.solidColumns[x & chunkMask];
+    uint32_t& nonAir = chunk.nonAirColumns[x & chunkMask];
+    solid = tileInfo[tile].solid ? solid | bit : solid & ~bit;
+    nonAir = tile != TILE_AIR ? nonAir | bit : nonAir & ~bit;
+}
+
+void World::SetTile(int x, int y, int tile) {
+    if (!CanEdit(x, y)) return;
+    int oldTile = GetTile(x, y);
+    at(x, y) = tile;
+    m_MarkOccupancy(x, y, tile);
+
+    if (tile != TILE_AIR) {
+        topNonAir[x] = std::min(topNonAir[x], y);
+    } else if (y == topNonAir[x]) {
+        topNonAir[x] = m_ScanDown(x, y + 1, false);
+    }
+
+    if (tileInfo[tile].solid) {
+        topSolid[x] = std::min(topSolid[x], y);
+    } else if (y == topSolid[x]) {
+        topSolid[x] = m_ScanDown(x, std::max(y + 1, topNonAir[x]), true);
+    }
+
+    m_UpdateLight(x, y, oldTile);
+}
+
+// Fresh, unedited air for a column about to be generated
+void World::m_ResetColumn(int chunkX) {
+    for (int cy = 0; cy < chunksY; ++cy) {
+        Chunk& chunk = chunks[cy * chunksX + chunkX];
+        m_OwnTiles(chunk);
+        std::fill_n(chunk.tiles, chunkArea, TILE_AIR);
+        std::fill_n(chunk.solidColumns, chunkSize, 0u);
+        std::fill_n(chunk.nonAirColumns, chunkSize, 0u);
+        chunk.version = ++versionClock;
+        chunk.edited = false;
+    }
+}
+
+// Builds one chunk column from the seed alone. Nothing here reads tiles outside the
+// column, so columns can be generated in any order and regenerate bit-identically.
+void World::GenerateColumn(int chunkX) {
+    m_ResetColumn(chunkX);
+    generationPipeline.RunColumn(*this, chunkX);
+}
+
+// Columns share no state, so every stage is spread over the generation pool. The result
+// is bit-identical for any thread count.
 void World::GenerateTerrain() {
-    std::cout << "Initializing Generation..." << std::endl;
-    InitBasicGen();
+    std::vector<int> columns(chunksX);
+    for (int cx = 0; cx < chunksX; ++cx) {
+        m_ResetColumn(cx);
+        columns[cx] = cx;
+    }
+
+    generationPipeline.ResetStats();
+    generationPipeline.Run(*this, m_GenerationPool(), columns);
+    RelightAll();
+    std::cout << "Generated " << chunksX << " chunk columns in " << generationPipeline.getWallMs()
+              << " ms on " << m_GenerationPool().getThreadCount() << " threads" << std::endl;
+}
 
-    std::cout << "Adding random long caves." << std::endl;
-    AddRandWorms(12, 30);
+void World::StartGenerating(int firstChunkX) {
+    FinishGenerating();
 
-    std::cout << "Adding dirt patches." << std::endl;
-    AddDirtPatches();
+    for (std::atomic<bool>& ready : columnReady) {
+        ready = false;
+    }
+    readyColumns = 0;
+    generationPipeline.ResetStats();
+    generating = true;
+
+    generationThread = std::thread([this, firstChunkX] {
+        std::vector<int> order(chunksX);
+        for (int cx = 0; cx < chunksX; ++cx) order[cx] = cx;
+        std::stable_sort(order.begin(), order.end(), [firstChunkX](int a, int b) {
+            return std::abs(a - firstChunkX) < std::abs(b - firstChunkX);
+        });
+
+        // A column is lit, and then ready, once it and both neighbours are generated.
+        // Whichever of the three finishes last claims the lighting.
+        std::unique_ptr<std::atomic<int>[]> stage(new std::atomic<int>[chunksX]); // 0 queued, 1 generated, 2 lit
+        for (int cx = 0; cx < chunksX; ++cx) stage[cx] = 0;
+        auto tryLight = [&](int cx) {
+            if (cx < 0 || cx >= chunksX) return;
+            for (int n = std::max(cx - 1, 0); n <= std::min(cx + 1, chunksX - 1); ++n) {
+                if (stage[n] == 0) return;
+            }
+            int generated = 1;
+            if (!stage[cx].compare_exchange_strong(generated, 2)) return;
+            RelightColumn(cx);
+            columnReady[cx] = true;
+            ++readyColumns;
+        };
+
+        // The pool hands out indices in order, so columns near firstChunkX finish first
+        auto start = std::chrono::steady_clock::now();
+        m_GenerationPool().ParallelFor(chunksX, [&](int i) {
+            int cx = order[i];
+            GenerateColumn(cx);
+            stage[cx] = 1;
+            for (int n = cx - 1; n <= cx + 1; ++n) tryLight(n);
+        });
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Generated " << chunksX << " chunk columns in " << ms << " ms in the background" << std::endl;
+
+        generating = false;
+    });
+}
 
-    std::cout << "Creating the surface." << std::endl;
-    ClearTopRowsToAir(0.00000000001);
+void World::FinishGenerating() {
+    if (generationThread.joinable()) generationThread.join();
+}
 
-    std::cout << "Adding grass." << std::endl;
-    AddGrass();
+bool World::IsGenerating() const { return generating; }
 
-    std::cout << "Adding trees." << std::endl;
-    AddTrees();
+bool World::IsColumnReady(int chunkX) const {
+    if (chunkX < 0 || chunkX >= chunksX) return false;
+    return columnReady[chunkX];
 }
 
+World::GenerationStatus World::GetGenerationStatus() const {
+    int runs = chunksX * (int)generationPipeline.getPasses().size();
+    float progress = runs > 0 ? (float)generationPipeline.getCompletedRuns() / runs : 1.0f;
+    return { std::min(progress, 1.0f), generationPipeline.getLastPassName(), readyColumns };
+}
 
-void World::Render(int camDrawX, int camDrawY, int windowWidth, int windowHeight, TextureManager& textureManager) {
-    int camX = camDrawX;
-    int camY = camDrawY;
+void World::SetGenerationThreads(unsigned int threads) {
+    generationPool = std::make_unique<ThreadPool>(threads);
+}
 
-    for (int y = 0; y < height; ++y) {
-        int tilePixelY = y * tileSize;
-        if ((tilePixelY + tileSize) <= camY || tilePixelY >= camY + windowHeight) continue;
+GenerationPipeline& World::getGenerationPipeline() { return generationPipeline; }
+
+ThreadPool& World::m_GenerationPool() {
+    if (!generationPool) generationPool = std::make_unique<ThreadPool>();
+    return *generationPool;
+}
+
+void World::EnableStreaming(const std::string& cacheDir) {
+    streaming = true;
+    streamCacheDir = cacheDir;
+
+    std::error_code ec;
+    std::filesystem::create_directories(streamCacheDir, ec);
+}
+
+// Evicted columns belong to one world, so a freshly generated world starts without them
+void World::ClearStreamCache() {
+    if (streamCacheDir.empty()) return;
+
+    std::error_code ec;
+    std::filesystem::remove_all(streamCacheDir, ec);
+    std::filesystem::create_directories(streamCacheDir, ec);
+}
+
+bool World::IsStreaming() const { return streaming; }
+int World::GetOriginChunkX() const { return originChunkX; }
+
+int World::UpdateStreaming(int focusTileX) {
+    if (!streaming || generating) return 0;
+
+    int focusChunk = focusTileX >> chunkShift; // arithmetic shift floors negatives
+    if (focusChunk >= streamMargin && focusChunk < chunksX - streamMargin) return 0;
+
+    int shift = focusChunk - chunksX / 2;
+    if (!m_ShiftWindow(shift)) return 0;
+    return shift * chunkSize;
+}
+
+bool World::m_ShiftWindow(int shift) {
+    if (shift == 0) return true;
+
+    // Edits that can't be written stay resident, the window waits until they can
+    for (int cx = 0; cx < chunksX; ++cx) {
+        if ((cx - shift < 0 || cx - shift >= chunksX) && !m_EvictColumn(cx)) return false;
+    }
+
+    // Surviving columns slide over so local column cx becomes cx - shift
+    if (std::abs(shift) < chunksX) {
+        for (int cy = 0; cy < chunksY; ++cy) {
+            auto rowBegin = chunks.begin() + cy * chunksX;
+            auto rowEnd = rowBegin + chunksX;
+            if (shift > 0) {
+                std::rotate(rowBegin, rowBegin + shift, rowEnd);
+            } else {
+                std::rotate(rowBegin, rowEnd + shift, rowEnd);
+            }
+        }
+
+        int tileShift = shift * chunkSize;
+        for (std::vector<int>* surface : { &topSolid, &topNonAir }) {
+            if (shift > 0) {
+                std::rotate(surface->begin(), surface->begin() + tileShift, surface->end());
+            } else {
+                std::rotate(surface->begin(), surface->end() + tileShift, surface->end());
+            }
+        }
+    }
+
+    originChunkX += shift;
+    std::cout << "Streaming window moved to chunk column " << originChunkX << std::endl;
+
+    // Only worms that can reach the window are worth keeping
+    for (auto it = wormPaths.begin(); it != wormPaths.end();) {
+        bool inReach = it->first >= originChunkX - wormReachChunks &&
+                       it->first < originChunkX + chunksX + wormReachChunks;
+        it = inReach ? std::next(it) : wormPaths.erase(it);
+    }
+
+    std::vector<int> entering;
+    for (int cx = 0; cx < chunksX; ++cx) {
+        if (cx + shift < 0 || cx + shift >= chunksX) entering.push_back(cx);
+    }
+    m_GenerationPool().ParallelFor(entering.size(), [&](int i) { m_LoadOrGenerateColumn(entering[i]); });
+
+    // Light stops at the window's edges, so survivors next to the entering columns were lit
+    // without them, and the survivor now at an edge was lit with a neighbour since evicted
+    std::vector<int> relight;
+    for (int cx = 0; cx < chunksX; ++cx) {
+        bool near = cx == 0 || cx == chunksX - 1;
+        for (int enter : entering) near = near || std::abs(enter - cx) <= 1;
+        if (near) relight.push_back(cx);
+    }
+    m_GenerationPool().ParallelFor(relight.size(), [&](int i) { RelightColumn(relight[i]); });
+    return true;
+}
+
+std::string World::m_ColumnPath(int absChunkX) const {
+    return streamCacheDir + "/column_" + std::to_string(absChunkX) + ".bin";
+}
+
+// Untouched columns are dropped since they regenerate from the seed; edited ones go to disk,
+// written next to any older copy and swapped in only once complete.
+bool World::m_EvictColumn(int chunkX) {
+    bool edited = false;
+    for (int cy = 0; cy < chunksY; ++cy) {
+        edited = edited || chunks[cy * chunksX + chunkX].edited;
+    }
+    if (!edited) return true;
+
+    std::string path = m_ColumnPath(originChunkX + chunkX);
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        uint8_t scratch[chunkArea];
+        for (int cy = 0; cy < chunksY && out; ++cy) {
+            const Chunk& chunk = chunks[cy * chunksX + chunkX];
+            out.write(reinterpret_cast<const char*>(m_ReadTiles(chunk, scratch)), chunkArea);
+        }
+        out.flush();
+        if (!out) {
+            TraceLog(LOG_ERROR, "Failed to write evicted column: %s", tempPath.c_str());
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        TraceLog(LOG_ERROR, "Failed to replace evicted column %s: %s", path.c_str(), ec.message().c_str());
+        return false;
+    }
+    return true;
+}
+
+void World::m_LoadOrGenerateColumn(int chunkX) {
+    std::string path = m_ColumnPath(originChunkX + chunkX);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        GenerateColumn(chunkX);
+        return;
+    }
 
-        for (int x = 0; x < width; ++x) {
-            int tilePixelX = x * tileSize;
-            if ((tilePixelX + tileSize) <= camX || tilePixelX >= camX + windowWidth) continue;
+    for (int cy = 0; cy < chunksY; ++cy) {
+        Chunk& chunk = chunks[cy * chunksX + chunkX];
+        m_OwnTiles(chunk);
+        in.read(reinterpret_cast<char*>(chunk.tiles), chunkArea);
+        chunk.version = ++versionClock;
+        chunk.edited = true; // still differs from the generated column
+    }
+    if (!in) {
+        TraceLog(LOG_WARNING, "Evicted column is truncated, regenerating: %s", path.c_str());
+        GenerateColumn(chunkX);
+        return;
+    }
+    for (int cy = 0; cy < chunksY; ++cy) {
+        const uint8_t* tiles = chunks[cy * chunksX + chunkX].tiles;
+        if (*std::max_element(tiles, tiles + chunkArea) >= TILE_COUNT) { // would index past tileInfo
+            TraceLog(LOG_WARNING, "Evicted column has unknown tiles, regenerating: %s", path.c_str());
+            GenerateColumn(chunkX);
+            return;
+        }
+    }
+
+    int x0 = chunkX * chunkSize;
+    UpdateSurface(x0, std::min(x0 + chunkSize, width));
+    m_BuildOccupancy(chunkX);
+}
+
+
+void World::WriteTiles(std::ostream& out) const {
+    uint8_t scratch[chunkArea];
+    for (const Chunk& chunk : chunks) {
+        out.write(reinterpret_cast<const char*>(m_ReadTiles(chunk, scratch)), chunkArea);
+    }
+}
+
+void World::WriteChunkFlags(std::ostream& out) const {
+    for (const Chunk& chunk : chunks) {
+        char edited = chunk.edited ? 1 : 0;
+        out.put(edited);
+    }
+}
+
+size_t World::getSavedIndexBytes() const {
+    return 2 * width * sizeof(int32_t) + chunks.size() * 2 * chunkSize * sizeof(uint32_t);
+}
+
+int World::getSavedLightBlocks() const {
+    return (int)std::count_if(chunks.begin(), chunks.end(),
+                              [](const Chunk& chunk) { return chunk.light || chunk.compressedLight; });
+}
+
+void World::WriteIndexes(std::ostream& out) const {
+    for (const std::vector<int>* surface : { &topSolid, &topNonAir }) {
+        for (int top : *surface) {
+            int32_t row = top;
+            out.write(reinterpret_cast<const char*>(&row), sizeof(row));
+        }
+    }
+    for (const Chunk& chunk : chunks) {
+        out.write(reinterpret_cast<const char*>(chunk.solidColumns), sizeof(chunk.solidColumns));
+        out.write(reinterpret_cast<const char*>(chunk.nonAirColumns), sizeof(chunk.nonAirColumns));
+    }
+}
+
+void World::WriteLight(std::ostream& out) const {
+    uint32_t block = 0;
+    for (const Chunk& chunk : chunks) {
+        uint32_t entry = chunk.light || chunk.compressedLight ? block++ : savedUniformLight | chunk.uniformLight;
+        out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    uint8_t scratch[chunkArea];
+    for (const Chunk& chunk : chunks) {
+        if (chunk.light) {
+            out.write(reinterpret_cast<const char*>(chunk.light), chunkArea);
+        } else if (chunk.compressedLight) {
+            chunk.compressedLight->Decompress(scratch);
+            out.write(reinterpret_cast<const char*>(scratch), chunkArea);
+        }
+    }
+}
+
+// Points every chunk straight at its tiles and light in the mapped save, which the caller has
+// checked are all in range. Only the surface index and occupancy masks are copied out.
+// Chunks only get their own memory once they are edited or streaming regenerates them.
+void World::UseMappedTiles(std::unique_ptr<MappedFile> file, const SaveLayout& layout, unsigned int savedSeed,
+                           int savedOriginChunkX) {
+    SetSeed(savedSeed);
+    originChunkX = savedOriginChunkX;
+
+    uint8_t* tileBase = file->data() + layout.tilesOffset;
+    const uint8_t* flags = file->data() + layout.flagsOffset;
+    const uint8_t* index = file->data() + layout.indexOffset;
+    const uint8_t* lightEntries = file->data() + layout.lightOffset;
+    uint8_t* lightBase = file->data() + layout.lightOffset + chunks.size() * sizeof(uint32_t);
+
+    for (std::vector<int>* surface : { &topSolid, &topNonAir }) {
+        for (int x = 0; x < width; ++x, index += sizeof(int32_t)) {
+            int32_t row;
+            std::memcpy(&row, index, sizeof(row));
+            (*surface)[x] = row;
+        }
+    }
 
-            int tile = tiles[y * width + x];
-            textureManager.WorldTextureManager(tile, camX, camY, tilePixelX, tilePixelY);
+    uint32_t stamp = ++versionClock;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        chunk.storage.reset();
+        chunk.compressed.reset();
+        chunk.tiles = tileBase + i * chunkArea;
+        chunk.version = ++versionClock;
+        chunk.edited = flags[i] != 0;
+
+        std::memcpy(chunk.solidColumns, index, sizeof(chunk.solidColumns));
+        index += sizeof(chunk.solidColumns);
+        std::memcpy(chunk.nonAirColumns, index, sizeof(chunk.nonAirColumns));
+        index += sizeof(chunk.nonAirColumns);
+
+        uint32_t entry;
+        std::memcpy(&entry, lightEntries + i * sizeof(entry), sizeof(entry));
+        chunk.lightStorage.reset();
+        chunk.compressedLight.reset();
+        if (entry & savedUniformLight) {
+            chunk.light = nullptr;
+            chunk.uniformLight = (uint8_t)entry;
+        } else {
+            chunk.light = lightBase + (size_t)entry * chunkArea;
         }
+        chunk.lightVersion = stamp;
     }
+    mappedSave = std::move(file);
+}
+
+// Draws the visible chunks from the render cache, rebaking the ones whose version moved
+// since they were last baked. Columns still generating and all-air chunks in full
+// daylight are skipped.
+void World::Render(int camDrawX, int camDrawY, int windowWidth, int windowHeight, TextureManager& textureManager) {
+    int chunkPixels = chunkSize * tileSize;
+    int firstX = std::max(0, camDrawX / chunkPixels);
+    int lastX = std::min(chunksX - 1, (camDrawX + windowWidth - 1) / chunkPixels);
+    int firstY = std::max(0, camDrawY / chunkPixels);
+    int lastY = std::min(chunksY - 1, (camDrawY + windowHeight - 1) / chunkPixels);
+
+    renderCache.BeginFrame();
+    for (int cy = firstY; cy <= lastY; ++cy) {
+        for (int cx = firstX; cx <= lastX; ++cx) {
+            if (!columnReady[cx]) continue; // still being generated
+
+            const Chunk& chunk = chunks[cy * chunksX + cx];
+            if (std::all_of(chunk.nonAirColumns, chunk.nonAirColumns + chunkSize, [](uint32_t bits) { return bits == 0; }) &&
+                m_FullyLit(chunk)) continue;
+
+            // Both versions come from one clock, so the larger moves whenever either does
+            int64_t key = (int64_t)(originChunkX + cx) * chunksY + cy;
+            int screenX = cx * chunkPixels - camDrawX;
+            int screenY = cy * chunkPixels - camDrawY;
+            ChunkRenderCache::BakeResult bake = renderCache.BeginBake(key, std::max(chunk.version, chunk.lightVersion));
+            if (bake == ChunkRenderCache::BAKE_UNCACHED) {
+                m_BakeChunk(cx, cy, screenX, screenY, textureManager); // more on screen than the cache holds
+                continue;
+            }
+            if (bake == ChunkRenderCache::BAKE_STARTED) {
+                m_BakeChunk(cx, cy, 0, 0, textureManager);
+                renderCache.EndBake();
+            }
+            renderCache.Draw(key, screenX, screenY);
+        }
+    }
+}
+
+// Brightness per light level, about 0.8 of the level above, with a floor so unlit caves
+// still show their outline
+static constexpr unsigned char lightShade[World::maxLight + 1] = {
+    24, 24, 24, 24, 24, 27, 34, 43, 53, 67, 84, 104, 131, 163, 204, 255,
+};
+
+// Tiles of one chunk with its corner at originX, originY: 0, 0 in the render target BeginBake
+// opened, or its screen position when drawn without the cache.
+// Tiles are tinted by their light; dark air gets a black overlay instead.
+void World::m_BakeChunk(int chunkX, int chunkY, int originX, int originY, TextureManager& textureManager) {
+    int x0 = chunkX * chunkSize;
+    int y0 = chunkY * chunkSize;
+    textureManager.BeginBatch();
+    for (int y = y0; y < std::min(y0 + chunkSize, height); ++y) {
+        for (int x = x0; x < std::min(x0 + chunkSize, width); ++x) {
+            int tile = GetTile(x, y);
+            unsigned char shade = lightShade[GetLight(x, y)];
+            int px = originX + (x - x0) * tileSize;
+            int py = originY + (y - y0) * tileSize;
+            if (tile != TILE_AIR) {
+                textureManager.WorldTextureManager(tile, 0, 0, px, py, { shade, shade, shade, 255 });
+            } else if (shade < 255) {
+                textureManager.BatchRect({ (float)px, (float)py, (float)tileSize, (float)tileSize },
+                                         { 0, 0, 0, (unsigned char)(255 - shade) });
+            }
+        }
+    }
+    textureManager.FlushBatch();
+}
+
+ChunkRenderCache& World::getRenderCache() { return renderCache; }
+
+void World::SetSeed(unsigned int newSeed) {
+    seed = newSeed;
+    perlin = PerlinNoise(seed);
+
+    std::lock_guard<std::mutex> lock(wormPathMutex);
+    wormPaths.clear();
+}
+
+uint64_t World::HashChunk(int chunkX, int chunkY) const {
+    uint8_t scratch[chunkArea];
+    const Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+    return HashBytes(m_ReadTiles(chunk, scratch), chunkArea);
+}
+
+uint64_t World::HashColumn(int chunkX) const {
+    uint64_t hash = 0;
+    for (int cy = 0; cy < chunksY; ++cy) {
+        hash = HashCombine(hash, HashChunk(chunkX, cy));
+    }
+    return hash;
+}
+
+void World::CopyColumn(int chunkX, uint8_t* out) const {
+    for (int cy = 0; cy < chunksY; ++cy) {
+        const Chunk& chunk = chunks[cy * chunksX + chunkX];
+        const uint8_t* tiles = m_ReadTiles(chunk, out + cy * chunkArea);
+        if (tiles != out + cy * chunkArea) std::copy(tiles, tiles + chunkArea, out + cy * chunkArea);
+    }
+}
+
+uint64_t World::Hash() const {
+    uint64_t hash = HashCombine(width, height);
+    for (int cx = 0; cx < chunksX; ++cx) {
+        hash = HashCombine(hash, HashColumn(cx));
+    }
+    return hash;
 }
 
 int World::getWidth() const { return width; }
 int World::getHeight() const { return height; }
+int World::getChunksX() const { return chunksX; }
+int World::getChunksY() const { return chunksY; }
+unsigned int World::getSeed() const { return seed; }
+
+uint32_t World::GetChunkVersion(int chunkX, int chunkY) const {
+    return chunks[chunkY * chunksX + chunkX].version;
+}
 
 int World::GetTileAtWorldPixel(float worldX, float worldY) const {
     int tileX = static_cast<int>(worldX) / tileSize;
     int tileY = static_cast<int>(worldY) / tileSize;
 
-    if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height) {
+    if (tileX < 0 || tileY < 0 || tileX >= width || tileY >= height || m_AnyUnready(tileX, tileX)) {
         return -1; // or TILE_AIR if you want a default
     }
 
-    return tiles[tileY * width + tileX];
+    return GetTile(tileX, tileY);
 }
-
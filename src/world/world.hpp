@@ -1,9 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <raylib.h>
 #include "../util/perlin.hpp"
+#include "../util/mappedFile.hpp"
+#include "../util/threadPool.hpp"
 #include "textureManager.hpp"
+#include "chunk.hpp"
+#include "chunkRenderCache.hpp"
+#include "generationPipeline.hpp"
 
 // You may want to extern tileSize if used outside World
 extern int tileSize;
@@ -17,45 +30,296 @@ public:
         TILE_DIRT_GRASS = 3,
         TILE_TREE_TRUNK = 4,
         TILE_TREE_LEAVES = 5,
+        TILE_COUNT
     };
 
-    World();
+    // Per tile type properties, indexed by tile id. Register new blocks here.
+    struct TileInfo {
+        bool solid;
+        bool breakable;
+        const char* dropName;
+        int dropItem;    // Item::ItemRenderType dropped when broken, -1 for none
+        int textureSlot; // TextureManager::TextureSlot, -1 for none
+        int lightEmit;   // block light level the tile gives off
+        int lightBlock;  // extra levels light loses entering the tile, maxLight is opaque
+    };
+
+    static constexpr int maxLight = 15;
+
+    static constexpr TileInfo tileInfo[TILE_COUNT] = {
+        // solid  breakable  dropName  dropItem  textureSlot                 lightEmit  lightBlock
+        { false, false, nullptr,  -1, -1,                              0, 0 },         // TILE_AIR
+        { true,  true,  "Stone",  0,  TextureManager::TEXTURE_STONE,   0, maxLight },  // TILE_STONE
+        { true,  true,  "Dirt",   1,  TextureManager::TEXTURE_DIRT,    0, maxLight },  // TILE_DIRT
+        { true,  true,  "Dirt",   1,  TextureManager::TEXTURE_GRASS,   0, maxLight },  // TILE_DIRT_GRASS
+        { false, true,  "Wood",   2,  TextureManager::TEXTURE_TRUNK,   0, maxLight },  // TILE_TREE_TRUNK
+        { false, true,  "Leaves", 3,  TextureManager::TEXTURE_LEAVES,  0, 1 },         // TILE_TREE_LEAVES
+    };
+
+    static constexpr const TileInfo& GetTileInfo(int tile) { return tileInfo[tile]; }
+
+    // The seed drives every random decision in generation, so a seed always builds the same world
+    explicit World(unsigned int seed = 2023, int width = 800, int height = 2000);
     ~World();
 
-    int& at(int x, int y);
+    // Hot accessors, defined inline below. at() bumps the owning chunk's version but is
+    // a raw write; edits should go through SetTile, which keeps the indexes below current.
+    uint8_t& at(int x, int y);
+    int GetTile(int x, int y) const;
+    void SetTile(int x, int y, int tile);
+
+    // Surface index: the topmost solid and topmost non-air row of every tile column, or
+    // getHeight() when there is none. Built during generation and kept up by SetTile.
+    int GetTopSolidY(int x) const;
+    int GetTopNonAirY(int x) const;
+    void UpdateSurface(int x0, int x1); // rescans the tile columns [x0, x1)
+
+    // Occupancy of the inclusive tile rectangle [x0, x1] x [y0, y1], answered from per-chunk
+    // column bitmasks with one test per tile column and chunk row. Tiles outside count as air.
+    bool AnySolid(int x0, int y0, int x1, int y1) const;
+    bool IsAllAir(int x0, int y0, int x1, int y1) const;
+
+    // First row from fromY towards toY, both inclusive and in either direction, with a
+    // solid tile in any of the columns [x0, x1]; -1 if there is none. Answered one chunk
+    // row at a time from the same bitmasks, so a long drop costs no more than a short one.
+    // FindSolidColumn is the same sideways, one test per column crossed.
+    int FindSolidRow(int x0, int x1, int fromY, int toY) const;
+    int FindSolidColumn(int y0, int y1, int fromX, int toX) const;
 
+    // Light, 0..maxLight per tile in two channels. Sky light enters along the top row and
+    // falls straight down without fading; any other step costs one level plus the lightBlock
+    // of the tile entered. Opaque tiles take the light of their lit side but pass none on.
+    // RelightColumn floods a column from scratch; SetTile re-propagates only around the edit.
+    int GetSkyLight(int x, int y) const;
+    int GetBlockLight(int x, int y) const;
+    int GetLight(int x, int y) const; // the brighter channel
+    void RelightColumn(int chunkX);   // reads the neighbour columns, writes only this one
+    void RelightAll();
+    int getLastLightUpdateTiles() const; // light levels the last SetTile wrote
+
+    // Generation runs the passes registered in the pipeline, see the constructor
     void GenerateTerrain();
-    void InitBasicGen(float scale = 0.06f, float threshold = -1.5f);
-    void ClearTopRowsToAir(float scale = 0.01f);
-    void AddDirtPatches(float noiseScale = 0.08f, float threshold = 0.8f);
-    void AddGrass();
+    void GenerateColumn(int chunkX); // touches only this column, safe to run in parallel; leaves it unlit
+    void SetGenerationThreads(unsigned int threads); // 0 = one per hardware thread
+    GenerationPipeline& getGenerationPipeline();
+
+    // Background generation: columns are built on a worker thread, nearest firstChunkX
+    // first, and each becomes readable once IsColumnReady says so. Streaming and
+    // compression wait until IsGenerating() is false. Until then the checked queries below
+    // (IsSolidTile, AnySolid, FindSolidRow and the rest) see a column that isn't ready as
+    // solid from top to bottom, so bodies stop at its edge, and SetTile ignores any column
+    // that CanEdit refuses. Raw GetTile and at() are unchecked and must stay on ready columns.
+    struct GenerationStatus {
+        float progress;   // 0..1 over every column and pass
+        const char* pass; // latest pass to finish, nullptr before any
+        int readyColumns;
+    };
+
+    void StartGenerating(int firstChunkX);
+    void FinishGenerating(); // waits for the worker
+    bool IsGenerating() const;
+    bool IsColumnReady(int chunkX) const;
+    GenerationStatus GetGenerationStatus() const;
+    void InitBasicGen(int x0, int x1, float scale = 0.06f, float threshold = -1.5f);
+    void ClearTopRowsToAir(int x0, int x1, float scale = 0.01f);
+    void AddDirtPatches(int x0, int x1, float noiseScale = 0.08f, float threshold = 0.8f);
+    void AddGrass(int x0, int x1);
     void DrawTileLine(int x0, int y0, int x1, int y1, int tileType);
     bool CanPlaceFractalTree(int x, int y, float angle, float length, int depth); 
     void PlaceLeafCluster(int x, int y);
     void AddFractalTree(int x, int y, float angle, float length, int depth);
-    void AddTrees();
-    void AddRandWorms(int minWorms = 4, int maxWorms = 12);
-    void AddPerlinWorm(int startX, int startY, int length, float noiseScale = 0.1f, int minRadius = 1, int maxRadius = 5);
+    void AddTrees(int x0, int x1);
+    void AddRandWorms(int x0, int x1);
+    void AddPerlinWorm(int startX, int startY, int length, float noiseScale, int minRadius, int maxRadius, int x0, int x1);
+
+    // Streaming keeps a fixed window of chunk columns resident and slides it along with
+    // the player. Tile coordinates stay local to the window (floating origin); column 0
+    // of the window is absolute chunk column GetOriginChunkX().
+    void EnableStreaming(const std::string& cacheDir);
+    void ClearStreamCache();
+    bool IsStreaming() const;
+    int GetOriginChunkX() const;
+    int UpdateStreaming(int focusTileX); // returns tiles everything local must move left by
+
+    // Cold chunk compression, see UpdateCompression. Compressed chunks still read through
+    // GetTile and expand on their first write through at(); their light is compressed with
+    // them and expands on its first change.
+    struct CompressionStats {
+        int compressedChunks = 0;
+        int uniformLightChunks = 0; // light held as one level
+        size_t residentBytes = 0;   // tile and light memory as currently stored
+        size_t rawBytes = 0;        // tile and light memory with every chunk expanded
+        size_t lightBytes = 0;      // the light's share of residentBytes
+    };
+
+    void UpdateCompression(int focusTileX, int focusTileY);
+    bool CompressChunk(int chunkX, int chunkY);
+    void DecompressChunk(int chunkX, int chunkY);
+    CompressionStats GetCompressionStats() const;
+
+    // Saves write the tile grid chunk by chunk in index order, so the file can be mapped
+    // back in and used as tile storage as is. Everything else a load would have to rebuild
+    // by reading every tile is saved too: the surface index and occupancy masks
+    // (WriteIndexes), and the light (WriteLight), one entry per chunk holding its level
+    // when uniform or else the number of its chunkArea block, which follow the entries.
+    struct SaveLayout {
+        size_t tilesOffset;
+        size_t flagsOffset;
+        size_t indexOffset;
+        size_t lightOffset;
+    };
+    static constexpr uint32_t savedUniformLight = 0x80000000u; // light entry flag, level in the low byte
+
+    void WriteTiles(std::ostream& out) const;
+    void WriteChunkFlags(std::ostream& out) const;
+    size_t getSavedIndexBytes() const;
+    int getSavedLightBlocks() const;
+    void WriteIndexes(std::ostream& out) const;
+    void WriteLight(std::ostream& out) const;
+    void UseMappedTiles(std::unique_ptr<MappedFile> file, const SaveLayout& layout, unsigned int savedSeed,
+                        int savedOriginChunkX);
 
     bool IsSolidTile(int tileX, int tileY) const;
-    bool IsTile(int tileX, int tileY) const;
+    bool IsTile(int tileX, int tileY) const; // a breakable tile that CanEdit allows editing
+    // Inside the world, and not being generated: the column and both its neighbours are
+    // ready, since the worker reads the neighbours of a column while it lights it
+    bool CanEdit(int tileX, int tileY) const;
 
+    // Draws one cached texture per visible chunk, see ChunkRenderCache. The cache holds GPU
+    // textures, so unload it before the window closes.
     void Render(int camDrawX, int camDrawY, int windowWidth, int windowHeight, TextureManager& textureManager);
+    ChunkRenderCache& getRenderCache();
 
     int getWidth() const;
     int getHeight() const;
+    unsigned int getSeed() const;
+    void SetSeed(unsigned int seed); // takes effect on the next generated column
+
+    // Content hashes of the resident tiles. A column is the generation region, so
+    // HashColumn pins down one GenerateColumn call; Hash covers the whole window.
+    uint64_t HashChunk(int chunkX, int chunkY) const;
+    uint64_t HashColumn(int chunkX) const;
+    uint64_t Hash() const;
+    void CopyColumn(int chunkX, uint8_t* out) const; // getChunksY() * chunkArea bytes, chunk by chunk
     int GetTileAtWorldPixel(float worldX, float worldY) const;
 
+    int getChunksX() const;
+    int getChunksY() const;
+    uint32_t GetChunkVersion(int chunkX, int chunkY) const;
+
 private:
+    struct WormDisc {
+        int x, y, radius; // absolute tile column
+    };
+    struct TileSpan {
+        int y, left, right; // inclusive local tile columns
+        bool operator<(const TileSpan& other) const {
+            return y != other.y ? y < other.y : left < other.left;
+        }
+    };
+
     int MapYToRadius(float y, int minRadius, int maxRadius);
+    void m_TraceWorm(int startX, int startY, int length, float noiseScale, int minRadius, int maxRadius,
+                     std::vector<WormDisc>& path);
+    std::shared_ptr<const std::vector<WormDisc>> m_WormPath(int sourceColumn);
+    void m_WormSpans(const std::vector<WormDisc>& path, int x0, int x1, std::vector<TileSpan>& spans) const;
+    void m_FillAir(std::vector<TileSpan>& spans);
+    uint8_t& TileRef(int x, int y); // generation writes, no version bump
+    void m_OwnTiles(Chunk& chunk);
+    const uint8_t* m_ReadTiles(const Chunk& chunk, uint8_t* scratch) const;
+    ThreadPool& m_GenerationPool();
+    void m_ResetColumn(int chunkX);
+    int m_ScanDown(int x, int fromY, bool solidOnly) const;
+    bool m_AnyOccupied(int x0, int y0, int x1, int y1, bool solidOnly) const;
+    bool m_AnyUnready(int x0, int x1) const; // any tile column in [x0, x1] still generating
+    bool m_IsSolid(int x, int y) const;      // IsSolidTile without the readiness check
+    void m_BuildOccupancy(int chunkX); // whole chunk column, from its tiles
+    void m_MarkOccupancy(int x, int y, int tile);
+    void m_PlaceTreeTile(int x, int y, int tile);
+    void m_TreeBounds(int x, int y, float angle, float length, int depth,
+                      int& minX, int& minY, int& maxX, int& maxY) const;
+    void m_BakeChunk(int chunkX, int chunkY, int originX, int originY, TextureManager& textureManager);
+    struct LightNode {
+        int x, y, level;
+    };
+    int m_OwnLight(int y, int tile, bool sky) const;
+    uint8_t m_PackedLight(int x, int y) const;
+    void m_ExpandLight(Chunk& chunk);   // gives a uniform or compressed chunk its own light block
+    void m_CompressLight(Chunk& chunk); // the reverse, when few enough levels are in it
+    void m_SetLight(int x, int y, bool sky, int level, uint32_t stamp);
+    bool m_InLightBounds(int x, int y) const;
+    void m_UpdateLight(int x, int y, int oldTile);
+    void m_UpdateLightChannel(int x, int y, int oldTile, bool sky, uint32_t stamp);
+    bool m_FullyLit(const Chunk& chunk) const;
+    bool m_ShiftWindow(int shift); // false when a leaving column couldn't be written, nothing moved
+    bool m_EvictColumn(int chunkX);
+    void m_LoadOrGenerateColumn(int chunkX);
+    std::string m_ColumnPath(int absChunkX) const;
+
+    unsigned int seed;
     PerlinNoise perlin;
 
-    static constexpr int width = 800;
-    static constexpr int height = 2000;
+    int width;
+    int height;
     static constexpr int dirtDepth = 400;
-    std::vector<int> tiles;
+    static constexpr int wormReachChunks = 7; // 200 worm steps + radius, in chunk columns
+    std::unordered_map<int, std::shared_ptr<const std::vector<WormDisc>>> wormPaths; // by source column
+    std::mutex wormPathMutex;
+    static constexpr int treeReach = 6;       // widest a tree gets either side of its root
+    int chunksX;
+    int chunksY;
+    std::vector<Chunk> chunks;
+    std::vector<int> topSolid;  // per tile column, see GetTopSolidY
+    std::vector<int> topNonAir; // per tile column, see GetTopNonAirY
+    std::atomic<uint32_t> versionClock{0}; // source of chunk versions, never reused
+    std::unique_ptr<ThreadPool> generationPool;
+    GenerationPipeline generationPipeline;
+    std::thread generationThread;
+    std::atomic<bool> generating{false};
+    std::vector<std::atomic<bool>> columnReady; // per chunk column
+    std::atomic<int> readyColumns{0};
+    std::unique_ptr<MappedFile> mappedSave; // backs chunk tiles after loading a save
 
-    Texture2D stoneTexture;
-    Texture2D dirtTexture;
+    std::vector<LightNode> lightRemoval; // SetTile's scratch queues, main thread only
+    std::vector<LightNode> lightAdd;
+    int lastLightUpdateTiles = 0;
+
+    static constexpr int compressionSweepChunks = 64; // chunks looked at per UpdateCompression
+    static constexpr int coldSweeps = 60;             // idle sweeps before a chunk is compressed
+    static constexpr int hotRadiusChunks = 3;         // chunks around the focus kept expanded
+    int compressionCursor = 0;
+
+    bool streaming = false;
+    static constexpr int streamMargin = 8; // recentre when the player is this many columns from an edge
+    int originChunkX = 0;
+    std::string streamCacheDir;
+
+    ChunkRenderCache renderCache;
 };
 
+inline uint8_t& World::at(int x, int y) {
+    Chunk& chunk = chunks[(y >> chunkShift) * chunksX + (x >> chunkShift)];
+    if (!chunk.tiles) m_OwnTiles(chunk);
+    chunk.version = ++versionClock;
+    chunk.edited = true;
+    return chunk.tiles[(y & chunkMask) * chunkSize + (x & chunkMask)];
+}
+
+inline uint8_t World::m_PackedLight(int x, int y) const {
+    const Chunk& chunk = chunks[(y >> chunkShift) * chunksX + (x >> chunkShift)];
+    if (chunk.light) return chunk.light[(y & chunkMask) * chunkSize + (x & chunkMask)];
+    if (chunk.compressedLight) return chunk.compressedLight->TileAt(x & chunkMask, y & chunkMask);
+    return chunk.uniformLight;
+}
+
+inline int World::GetSkyLight(int x, int y) const { return m_PackedLight(x, y) >> 4; }
+
+inline int World::GetBlockLight(int x, int y) const { return m_PackedLight(x, y) & 0x0F; }
+
+inline int World::GetLight(int x, int y) const { return std::max(GetSkyLight(x, y), GetBlockLight(x, y)); }
+
+inline int World::GetTile(int x, int y) const {
+    const Chunk& chunk = chunks[(y >> chunkShift) * chunksX + (x >> chunkShift)];
+    if (!chunk.tiles) return chunk.compressed->TileAt(x & chunkMask, y & chunkMask);
+    return chunk.tiles[(y & chunkMask) * chunkSize + (x & chunkMask)];
+}
@@ -0,0 +1,292 @@
+#include "world.hpp"
+
+// Light is flood filled: a tile's level is the best any neighbour hands it, or its own
+// (the sky along the top row, lightEmit for block light), whichever is brighter.
+
+static int ChannelLevel(uint8_t packed, bool sky) { return sky ? packed >> 4 : packed & 0x0F; }
+
+static uint8_t WithChannelLevel(uint8_t packed, bool sky, int level) {
+    return sky ? (uint8_t)((packed & 0x0F) | level << 4) : (uint8_t)((packed & 0xF0) | level);
+}
+
+// Level a tile reaches from a neighbour at level. skyDown is sky light falling into it
+// from straight above, which keeps full strength through clear tiles.
+static int SpreadLight(int level, const World::TileInfo& into, bool skyDown) {
+    if (into.lightBlock >= World::maxLight) return level - 1; // lit face, goes no further
+    if (skyDown && level == World::maxLight) return World::maxLight - into.lightBlock;
+    return level - 1 - into.lightBlock;
+}
+
+static bool PassesLight(const World::TileInfo& info, bool sky) {
+    return info.lightBlock < World::maxLight || (!sky && info.lightEmit > 0);
+}
+
+static const int lightDx[4] = { -1, 1, 0, 0 };
+static const int lightDy[4] = { 0, 0, -1, 1 }; // the last one is down
+
+int World::getLastLightUpdateTiles() const { return lastLightUpdateTiles; }
+
+int World::m_OwnLight(int y, int tile, bool sky) const {
+    if (sky) return y == 0 ? SpreadLight(maxLight, tileInfo[tile], true) : 0;
+    return tileInfo[tile].lightEmit;
+}
+
+void World::m_ExpandLight(Chunk& chunk) {
+    if (chunk.lightStorage) return;
+    chunk.lightStorage = std::make_unique<uint8_t[]>(chunkArea);
+    if (chunk.light) {
+        std::copy(chunk.light, chunk.light + chunkArea, chunk.lightStorage.get());
+    } else if (chunk.compressedLight) {
+        chunk.compressedLight->Decompress(chunk.lightStorage.get());
+    } else {
+        std::fill_n(chunk.lightStorage.get(), chunkArea, chunk.uniformLight);
+    }
+    chunk.compressedLight.reset();
+    chunk.light = chunk.lightStorage.get();
+}
+
+void World::m_CompressLight(Chunk& chunk) {
+    if (!chunk.light) return;
+    auto compressed = std::make_unique<CompressedChunk>();
+    if (!CompressedChunk::Compress(chunk.light, *compressed)) return;
+
+    if (compressed->paletteSize == 1) {
+        chunk.uniformLight = compressed->palette[0];
+    } else {
+        chunk.compressedLight = std::move(compressed);
+    }
+    chunk.lightStorage.reset();
+    chunk.light = nullptr;
+}
+
+// stamp is a fresh version for every update, so each chunk it touches is bumped once
+void World::m_SetLight(int x, int y, bool sky, int level, uint32_t stamp) {
+    Chunk& chunk = chunks[(y >> chunkShift) * chunksX + (x >> chunkShift)];
+    if (!chunk.light) m_ExpandLight(chunk);
+    uint8_t& packed = chunk.light[(y & chunkMask) * chunkSize + (x & chunkMask)];
+    packed = WithChannelLevel(packed, sky, level);
+    chunk.lightVersion = stamp;
+    ++lastLightUpdateTiles;
+}
+
+// While columns are still generating, their light belongs to the worker; edits then only
+// re-propagate through ready columns and the worker lights the rest when it gets there.
+bool World::m_InLightBounds(int x, int y) const {
+    if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height) return false;
+    return !generating || columnReady[x >> chunkShift];
+}
+
+void World::m_UpdateLight(int x, int y, int oldTile) {
+    uint32_t stamp = ++versionClock;
+    lastLightUpdateTiles = 0;
+    m_UpdateLightChannel(x, y, oldTile, true, stamp);
+    m_UpdateLightChannel(x, y, oldTile, false, stamp);
+}
+
+// Two passes from the edited tile. Removal darkens every tile that could have taken its
+// light through the old tile and collects the lit tiles around that area; the add pass
+// then floods back in from them, the edited tile's own light and its neighbours.
+void World::m_UpdateLightChannel(int x, int y, int oldTile, bool sky, uint32_t stamp) {
+    lightRemoval.clear();
+    lightAdd.clear();
+
+    int tile = GetTile(x, y);
+    int oldLevel = ChannelLevel(m_PackedLight(x, y), sky);
+    int own = m_OwnLight(y, tile, sky);
+    if (oldLevel != own) m_SetLight(x, y, sky, own, stamp);
+    if (own > 0) lightAdd.push_back({ x, y, own });
+    if (oldLevel > 0 && PassesLight(tileInfo[oldTile], sky)) lightRemoval.push_back({ x, y, oldLevel });
+
+    for (size_t i = 0; i < lightRemoval.size(); ++i) {
+        LightNode node = lightRemoval[i];
+        for (int d = 0; d < 4; ++d) {
+            int nx = node.x + lightDx[d];
+            int ny = node.y + lightDy[d];
+            if (!m_InLightBounds(nx, ny)) continue;
+
+            int level = sky ? GetSkyLight(nx, ny) : GetBlockLight(nx, ny);
+            if (level == 0) continue;
+
+            bool dependent = level < node.level || (sky && d == 3 && node.level == maxLight && level == maxLight);
+            if (!dependent) {
+                lightAdd.push_back({ nx, ny, level });
+                continue;
+            }
+
+            int neighbourTile = GetTile(nx, ny);
+            int neighbourOwn = m_OwnLight(ny, neighbourTile, sky);
+            m_SetLight(nx, ny, sky, neighbourOwn, stamp);
+            if (neighbourOwn > 0) lightAdd.push_back({ nx, ny, neighbourOwn });
+            if (PassesLight(tileInfo[neighbourTile], sky)) {
+                lightRemoval.push_back({ nx, ny, level });
+                continue;
+            }
+
+            // An opaque tile is not expanded, so relight its face from the other sides here
+            for (int e = 0; e < 4; ++e) {
+                int ex = nx + lightDx[e];
+                int ey = ny + lightDy[e];
+                if (!m_InLightBounds(ex, ey)) continue;
+                int edge = sky ? GetSkyLight(ex, ey) : GetBlockLight(ex, ey);
+                if (edge > 0) lightAdd.push_back({ ex, ey, edge });
+            }
+        }
+    }
+
+    // The edited tile may now let in light it used to block
+    for (int d = 0; d < 4; ++d) {
+        int nx = x + lightDx[d];
+        int ny = y + lightDy[d];
+        if (!m_InLightBounds(nx, ny)) continue;
+        int level = sky ? GetSkyLight(nx, ny) : GetBlockLight(nx, ny);
+        if (level > 0) lightAdd.push_back({ nx, ny, level });
+    }
+
+    for (size_t i = 0; i < lightAdd.size(); ++i) {
+        LightNode node = lightAdd[i];
+        int level = sky ? GetSkyLight(node.x, node.y) : GetBlockLight(node.x, node.y);
+        if (level != node.level || !PassesLight(tileInfo[GetTile(node.x, node.y)], sky)) continue; // raised since, or opaque
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = node.x + lightDx[d];
+            int ny = node.y + lightDy[d];
+            if (!m_InLightBounds(nx, ny)) continue;
+
+            int reach = SpreadLight(level, tileInfo[GetTile(nx, ny)], sky && d == 3);
+            int current = sky ? GetSkyLight(nx, ny) : GetBlockLight(nx, ny);
+            if (reach > current) {
+                m_SetLight(nx, ny, sky, reach, stamp);
+                lightAdd.push_back({ nx, ny, reach });
+            }
+
+            // Full sky light falls the whole run at once, before anything spreads sideways
+            // from it at a lower level and has to be raised again
+            while (sky && d == 3 && reach == maxLight && m_InLightBounds(nx, ny + 1)) {
+                ++ny;
+                reach = SpreadLight(maxLight, tileInfo[GetTile(nx, ny)], true);
+                if (reach <= GetSkyLight(nx, ny)) break;
+                m_SetLight(nx, ny, sky, reach, stamp);
+                lightAdd.push_back({ nx, ny, reach });
+            }
+        }
+    }
+}
+
+// Light reaches at most maxLight tiles sideways, less than a chunk, so the neighbour
+// columns hold every tile that can light this one. Tiles beyond them count as absent.
+void World::RelightColumn(int chunkX) {
+    static_assert(maxLight < chunkSize, "light must not reach past the neighbour columns");
+
+    int x0 = std::max(0, (chunkX - 1) * chunkSize);
+    int x1 = std::min(width, (chunkX + 2) * chunkSize);
+    int w = x1 - x0;
+    int area = w * height;
+
+    thread_local std::vector<uint8_t> tiles, sky, block;
+    thread_local std::vector<int> queue;
+    tiles.resize(area);
+    sky.assign(area, 0);
+    block.assign(area, 0);
+
+    uint8_t scratch[chunkArea];
+    for (int cx = x0 >> chunkShift; cx < (x1 + chunkMask) >> chunkShift; ++cx) {
+        int left = cx * chunkSize - x0;
+        int columns = std::min(chunkSize, x1 - cx * chunkSize);
+        for (int cy = 0; cy < chunksY; ++cy) {
+            const uint8_t* chunkTiles = m_ReadTiles(chunks[cy * chunksX + cx], scratch);
+            int rows = std::min(chunkSize, height - cy * chunkSize);
+            for (int ly = 0; ly < rows; ++ly) {
+                std::copy_n(chunkTiles + ly * chunkSize, columns, &tiles[(cy * chunkSize + ly) * w + left]);
+            }
+        }
+    }
+
+    for (bool skyChannel : { true, false }) {
+        std::vector<uint8_t>& levels = skyChannel ? sky : block;
+        queue.clear();
+        if (skyChannel) {
+            // Seeded with every run of full sky light falling from the top row
+            for (int x = 0; x < w; ++x) {
+                int level = m_OwnLight(0, tiles[x], true);
+                for (int y = 0;;) {
+                    levels[y * w + x] = level;
+                    queue.push_back(y * w + x);
+                    if (level != maxLight || ++y == height) break;
+                    level = SpreadLight(maxLight, tileInfo[tiles[y * w + x]], true);
+                }
+            }
+        } else {
+            for (int i = 0; i < area; ++i) {
+                levels[i] = tileInfo[tiles[i]].lightEmit;
+                if (levels[i] > 0) queue.push_back(i);
+            }
+        }
+
+        for (size_t i = 0; i < queue.size(); ++i) {
+            int index = queue[i];
+            int level = levels[index];
+            if (level == 0 || !PassesLight(tileInfo[tiles[index]], skyChannel)) continue;
+
+            int x = index % w;
+            int y = index / w;
+            for (int d = 0; d < 4; ++d) {
+                int nx = x + lightDx[d];
+                int ny = y + lightDy[d];
+                if ((unsigned)nx >= (unsigned)w || (unsigned)ny >= (unsigned)height) continue;
+
+                int neighbour = ny * w + nx;
+                int reach = SpreadLight(level, tileInfo[tiles[neighbour]], skyChannel && d == 3);
+                if (reach > levels[neighbour]) {
+                    levels[neighbour] = reach;
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+    }
+
+    uint32_t stamp = ++versionClock;
+    int left = chunkX * chunkSize - x0;
+    int columns = std::min(chunkSize, width - chunkX * chunkSize);
+    uint8_t levels[chunkArea];
+    for (int cy = 0; cy < chunksY; ++cy) {
+        Chunk& chunk = chunks[cy * chunksX + chunkX];
+        int rows = std::min(chunkSize, height - cy * chunkSize);
+        std::fill_n(levels, chunkArea, 0);
+        for (int ly = 0; ly < rows; ++ly) {
+            int row = (cy * chunkSize + ly) * w + left;
+            for (int lx = 0; lx < columns; ++lx) {
+                levels[ly * chunkSize + lx] = (uint8_t)(sky[row + lx] << 4 | block[row + lx]);
+            }
+        }
+
+        // Most chunks are open sky or unlit rock and need no block of their own
+        chunk.compressedLight.reset();
+        if (std::all_of(levels, levels + chunkArea, [&](uint8_t level) { return level == levels[0]; })) {
+            chunk.lightStorage.reset();
+            chunk.light = nullptr;
+            chunk.uniformLight = levels[0];
+        } else {
+            if (!chunk.lightStorage) {
+                chunk.light = nullptr;
+                m_ExpandLight(chunk);
+            }
+            std::copy(levels, levels + chunkArea, chunk.light);
+        }
+        chunk.lightVersion = stamp;
+    }
+}
+
+void World::RelightAll() {
+    m_GenerationPool().ParallelFor(chunksX, [this](int cx) { RelightColumn(cx); });
+}
+
+// All-air chunks are only skipped when drawing if nothing in them is darkened
+bool World::m_FullyLit(const Chunk& chunk) const {
+    auto skyLit = [](uint8_t packed) { return packed >> 4 == maxLight; };
+    if (chunk.light) return std::all_of(chunk.light, chunk.light + chunkArea, skyLit);
+    if (chunk.compressedLight) {
+        const CompressedChunk& packed = *chunk.compressedLight;
+        return std::all_of(packed.palette, packed.palette + packed.paletteSize, skyLit);
+    }
+    return skyLit(chunk.uniformLight);
+}